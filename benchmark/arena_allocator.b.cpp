@@ -0,0 +1,83 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Per-task scratch buffers: every task allocates a handful of differently sized buffers and frees
+ * them at its end. Compares generic::allocator (new[] / delete[] per buffer) with an arena which is
+ * reset once per task.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+#include <glados/generic/allocator.h>
+#include <glados/generic/arena_allocator.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr auto tasks = 200000;
+    constexpr auto buffers = 8;
+
+    template <class Alloc, class EndOfTask>
+    auto run(Alloc& alloc, EndOfTask end_of_task) -> double
+    {
+        float* scratch[buffers];
+        auto sum = 0.f;
+
+        auto start = clock_type::now();
+        for(auto t = 0; t < tasks; ++t)
+        {
+            for(auto i = 0; i < buffers; ++i)
+            {
+                scratch[i] = alloc.allocate(static_cast<std::size_t>(256 << (i % 4)));
+                scratch[i][0] = static_cast<float>(i);
+            }
+
+            for(auto i = 0; i < buffers; ++i)
+            {
+                sum += scratch[i][0];
+                alloc.deallocate(scratch[i]);
+            }
+            end_of_task();
+        }
+        auto ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+
+        if(sum < 0.f)
+            std::printf("%f\n", static_cast<double>(sum));
+        return ns / (static_cast<double>(tasks) * buffers);
+    }
+}
+
+auto main() -> int
+{
+    auto heap = glados::generic::allocator<float, glados::memory_layout::pointer_1D>{};
+    auto a = glados::generic::arena{};
+    auto arena = glados::generic::arena_allocator<float, glados::memory_layout::pointer_1D>{a};
+
+    std::printf("%-10s %22s\n", "allocator", "allocate + free [ns]");
+    std::printf("%-10s %22.1f\n", "new[]", run(heap, []() {}));
+    std::printf("%-10s %22.1f\n", "arena", run(arena, [&a]() { a.reset(); }));
+    return 0;
+}
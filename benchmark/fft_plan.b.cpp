@@ -0,0 +1,92 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Ramp filtering of a detector row as a filtered backprojection task does it: the cost of planning
+ * its transforms anew, of taking them from fft::plan_cache and of filtering one row.
+ */
+
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <glados/fft/plan.h>
+#include <glados/fft/plan_cache.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+    using r2c_plan = glados::fft::plan<glados::fft::type::r2c>;
+    using c2r_plan = glados::fft::plan<glados::fft::type::c2r>;
+
+    constexpr auto tasks = 200;
+
+    auto filter(r2c_plan& forward, c2r_plan& backward, std::vector<float>& row, std::vector<std::complex<float>>& spectrum)
+    -> void
+    {
+        forward.execute(row.data(), spectrum.data());
+        for(auto k = std::size_t{0}; k < spectrum.size(); ++k)
+            spectrum[k] *= static_cast<float>(k) / static_cast<float>(row.size());
+        backward.execute(spectrum.data(), row.data());
+    }
+}
+
+auto main() -> int
+{
+    std::printf("%-8s %14s %14s %14s\n", "width", "plan [us]", "cache [us]", "row [us]");
+    for(auto width : {1000, 1024, 2000, 2048, 1009})
+    {
+        // detector rows are zero-padded to twice their width before filtering
+        auto n = 2 * width;
+        auto row = std::vector<float>(n, 1.f);
+        auto spectrum = std::vector<std::complex<float>>(n / 2 + 1);
+
+        auto start = clock_type::now();
+        for(auto t = 0; t < tasks; ++t)
+        {
+            auto forward = r2c_plan{n};
+            auto backward = c2r_plan{n};
+        }
+        auto planned = std::chrono::duration<double, std::micro>(clock_type::now() - start).count() / tasks;
+
+        start = clock_type::now();
+        for(auto t = 0; t < tasks; ++t)
+        {
+            auto forward = glados::fft::plan_cache<r2c_plan>::instance().get(n);
+            auto backward = glados::fft::plan_cache<c2r_plan>::instance().get(n);
+        }
+        auto cached = std::chrono::duration<double, std::micro>(clock_type::now() - start).count() / tasks;
+
+        auto forward = glados::fft::plan_cache<r2c_plan>::instance().get(n);
+        auto backward = glados::fft::plan_cache<c2r_plan>::instance().get(n);
+        start = clock_type::now();
+        for(auto t = 0; t < tasks; ++t)
+            filter(*forward, *backward, row, spectrum);
+        auto filtered = std::chrono::duration<double, std::micro>(clock_type::now() - start).count() / tasks;
+
+        std::printf("%-8d %14.2f %14.2f %14.2f\n", width, planned, cached, filtered);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * TLB pressure: random reads spread over a 256 MiB volume. Compares generic::allocator with
+ * huge_page_allocator, which is backed by transparent huge pages if the kernel allows it.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <glados/generic/allocator.h>
+#include <glados/generic/huge_page_allocator.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr auto dim = std::size_t{256};
+    constexpr auto elements = dim * dim * dim * 4;
+    constexpr auto reads = 1u << 24;
+
+    template <class Alloc>
+    auto random_reads() -> double
+    {
+        auto alloc = Alloc{};
+        auto p = alloc.allocate(dim, dim, dim * 4);
+        for(auto i = std::size_t{0}; i < elements; ++i)
+            p[i] = static_cast<std::uint32_t>(i);
+
+        auto state = std::uint64_t{88172645463325252ull};
+        auto sum = std::uint64_t{0};
+        auto start = clock_type::now();
+        for(auto i = 0u; i < reads; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            sum += p[state % elements];
+        }
+        auto ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+
+        alloc.deallocate(p, dim, dim, dim * 4);
+        if(sum == 42)
+            std::printf("%llu\n", static_cast<unsigned long long>(sum));
+        return ns / reads;
+    }
+}
+
+auto main() -> int
+{
+    using glados::memory_layout;
+
+    std::printf("%-12s %14s\n", "allocator", "read [ns]");
+    std::printf("%-12s %14.2f\n", "new[]", random_reads<glados::generic::allocator<std::uint32_t, memory_layout::pointer_3D>>());
+    std::printf("%-12s %14.2f\n", "huge pages", random_reads<glados::generic::huge_page_allocator<std::uint32_t, memory_layout::pointer_3D>>());
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * A 3x3x3 box filter over a volume: plain nested loops on one thread against generic::launch
+ * with its default tiles.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <glados/generic/launch.h>
+#include <glados/generic/thread_pool.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr auto rounds = 5;
+
+    template <class Run>
+    auto seconds(Run run) -> double
+    {
+        run();
+        auto start = clock_type::now();
+        for(auto i = 0; i < rounds; ++i)
+            run();
+        return std::chrono::duration<double>(clock_type::now() - start).count() / rounds;
+    }
+}
+
+auto main() -> int
+{
+    constexpr auto w = std::size_t{256};
+    constexpr auto h = std::size_t{256};
+    constexpr auto d = std::size_t{128};
+
+    auto in = std::vector<float>(w * h * d, 1.f);
+    auto out = std::vector<float>(w * h * d, 0.f);
+
+    auto filter = [&](std::size_t x, std::size_t y, std::size_t z) {
+        if(x == 0 || y == 0 || z == 0 || x == w - 1 || y == h - 1 || z == d - 1)
+            return;
+
+        auto sum = 0.f;
+        for(auto k = z - 1; k <= z + 1; ++k)
+            for(auto j = y - 1; j <= y + 1; ++j)
+                for(auto i = x - 1; i <= x + 1; ++i)
+                    sum += in[(k * h + j) * w + i];
+        out[(z * h + y) * w + x] = sum / 27.f;
+    };
+
+    auto serial = seconds([&]() {
+        for(auto z = std::size_t{0}; z < d; ++z)
+            for(auto y = std::size_t{0}; y < h; ++y)
+                for(auto x = std::size_t{0}; x < w; ++x)
+                    filter(x, y, z);
+    });
+
+    glados::generic::thread_pool pool;
+    auto launched = seconds([&]() { glados::generic::launch(pool, w, h, d, filter); });
+
+    std::printf("%-10s %12s %12s\n", "threads", "serial [ms]", "launch [ms]");
+    std::printf("%-10zu %12.2f %12.2f\n", pool.size() + 1, serial * 1e3, launched * 1e3);
+    return 0;
+}
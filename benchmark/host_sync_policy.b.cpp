@@ -0,0 +1,72 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Host-to-host staging copies of a volume: std::memcpy against generic::sync_policy, which
+ * spreads large copies over threads and writes them with non-temporal stores.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <glados/cuda/algorithm.h>
+#include <glados/generic/sync_policy.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr auto rounds = 20;
+
+    template <class Copy>
+    auto bandwidth(std::size_t bytes, Copy copy) -> double
+    {
+        copy();
+        auto start = clock_type::now();
+        for(auto i = 0; i < rounds; ++i)
+            copy();
+        auto s = std::chrono::duration<double>(clock_type::now() - start).count();
+        return static_cast<double>(bytes) * rounds / s / 1e9;
+    }
+}
+
+auto main() -> int
+{
+    std::printf("%-10s %14s %18s\n", "size", "memcpy [GB/s]", "sync_policy [GB/s]");
+    for(auto mib = std::size_t{1}; mib <= 256; mib *= 4)
+    {
+        auto n = (mib << 20) / sizeof(float);
+        auto src = std::unique_ptr<float[]>{new float[n]};
+        auto dst = std::unique_ptr<float[]>{new float[n]};
+        std::fill(src.get(), src.get() + n, 1.f);
+
+        auto plain = bandwidth(n * sizeof(float), [&]() { std::memcpy(dst.get(), src.get(), n * sizeof(float)); });
+        auto policy = bandwidth(n * sizeof(float), [&]() { glados::cuda::copy(glados::generic::sync, dst, src, n); });
+        std::printf("%4zu MiB   %14.2f %18.2f\n", mib, plain, policy);
+    }
+    return 0;
+}
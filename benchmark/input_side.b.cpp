@@ -0,0 +1,105 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Compares the wait policies of input_side:
+ *  - hand-off latency: two threads play ping-pong through two input_sides
+ *  - CPU usage: a consumer waits for a producer which emits one item per millisecond
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+
+#include <glados/pipeline/input_side.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+    using glados::pipeline::input_side;
+    using glados::pipeline::wait_policy;
+
+    auto ping_pong(wait_policy policy, int rounds) -> double
+    {
+        auto ping = input_side<int>{0, policy};
+        auto pong = input_side<int>{0, policy};
+
+        auto partner = std::thread{[&]() {
+            for(auto i = 0; i < rounds; ++i)
+                pong.input(ping.take());
+        }};
+
+        auto start = clock_type::now();
+        for(auto i = 0; i < rounds; ++i)
+        {
+            ping.input(int{i});
+            pong.take();
+        }
+        auto stop = clock_type::now();
+        partner.join();
+
+        auto ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        return ns / (2.0 * rounds);
+    }
+
+    auto idle_cpu(wait_policy policy, int items) -> double
+    {
+        auto queue = input_side<int>{0, policy};
+
+        auto cpu_start = std::clock();
+        auto wall_start = clock_type::now();
+
+        auto consumer = std::thread{[&]() {
+            for(auto i = 0; i < items; ++i)
+                queue.take();
+        }};
+
+        for(auto i = 0; i < items; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            queue.input(int{i});
+        }
+        consumer.join();
+
+        auto cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+        auto wall = std::chrono::duration<double>(clock_type::now() - wall_start).count();
+        return 100.0 * cpu / wall;
+    }
+
+    auto report(const char* name, wait_policy policy) -> void
+    {
+        constexpr auto rounds = 100000;
+        constexpr auto items = 500;
+
+        std::printf("%-16s %14.1f %12.1f\n", name, ping_pong(policy, rounds), idle_cpu(policy, items));
+    }
+}
+
+auto main() -> int
+{
+    std::printf("%-16s %14s %12s\n", "policy", "hand-off [ns]", "idle CPU [%]");
+    report("yield_wait", glados::pipeline::yield_wait);
+    report("block_wait", glados::pipeline::block_wait);
+    report("spin_then_park", glados::pipeline::spin_then_park);
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Block recycling under contention: every thread repeatedly takes a few blocks from a shared pool
+ * and gives them back. Compares pool_allocator with the previous free list, a std::forward_list
+ * behind a yielding spin lock.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <forward_list>
+#include <thread>
+#include <vector>
+
+#include <glados/generic/allocator.h>
+#include <glados/memory.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+    using host_allocator = glados::generic::allocator<float, glados::memory_layout::pointer_1D>;
+
+    constexpr auto block_size = 1024;
+    constexpr auto batch = 4;
+    constexpr auto rounds = 200000;
+
+    class locked_pool
+    {
+        public:
+            ~locked_pool()
+            {
+                for(auto p : list_)
+                    alloc_.deallocate(p);
+            }
+
+            auto allocate(std::size_t n) -> float*
+            {
+                while(lock_.test_and_set(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                auto ret = static_cast<float*>(nullptr);
+                if(list_.empty())
+                    ret = alloc_.allocate(n);
+                else
+                {
+                    ret = list_.front();
+                    list_.pop_front();
+                }
+
+                lock_.clear(std::memory_order_release);
+                return ret;
+            }
+
+            auto deallocate(float* p) -> void
+            {
+                while(lock_.test_and_set(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                list_.push_front(p);
+                lock_.clear(std::memory_order_release);
+            }
+
+        private:
+            host_allocator alloc_;
+            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+            std::forward_list<float*> list_;
+    };
+
+    // returns million allocate/deallocate pairs per second over all threads
+    template <class Pool>
+    auto contention(Pool& pool, int threads) -> double
+    {
+        auto workers = std::vector<std::thread>{};
+        auto start = clock_type::now();
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&pool]() {
+                float* blocks[batch];
+                for(auto i = 0; i < rounds; ++i)
+                {
+                    for(auto&& b : blocks)
+                        b = pool.allocate(block_size);
+                    for(auto&& b : blocks)
+                        pool.deallocate(b);
+                }
+            });
+        }
+
+        for(auto&& w : workers)
+            w.join();
+
+        auto s = std::chrono::duration<double>(clock_type::now() - start).count();
+        return static_cast<double>(threads) * rounds * batch / s / 1e6;
+    }
+}
+
+auto main() -> int
+{
+    auto max_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 4u));
+
+    std::printf("%-8s %18s %18s\n", "threads", "spin lock [M/s]", "pool [M/s]");
+    for(auto threads = 1; threads <= max_threads; threads *= 2)
+    {
+        locked_pool locked;
+        auto pool = glados::pool_allocator<float, glados::memory_layout::pointer_1D, host_allocator>{};
+
+        auto l = contention(locked, threads);
+        auto p = contention(pool, threads);
+        pool.release();
+
+        std::printf("%-8d %18.1f %18.1f\n", threads, l, p);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Measures the hand-off throughput of spsc_queue against blocking_queue for a range of element sizes.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <utility>
+
+#include <glados/pipeline/blocking_queue.h>
+#include <glados/pipeline/spsc_queue.h>
+
+namespace
+{
+    template <std::size_t Size>
+    struct tile
+    {
+        std::array<unsigned char, Size> data;
+    };
+
+    template <class Queue>
+    auto items_per_second(std::size_t items) -> double
+    {
+        using value_type = decltype(std::declval<Queue&>().pop());
+        auto queue = Queue{1024, glados::pipeline::spin_then_park};
+
+        auto start = std::chrono::steady_clock::now();
+        auto consumer = std::thread{[&]() {
+            for(auto i = std::size_t{0}; i < items; ++i)
+                queue.pop();
+        }};
+
+        for(auto i = std::size_t{0}; i < items; ++i)
+            queue.push(value_type{});
+
+        consumer.join();
+        auto stop = std::chrono::steady_clock::now();
+
+        return static_cast<double>(items) / std::chrono::duration<double>(stop - start).count();
+    }
+
+    template <std::size_t Size>
+    auto report(std::size_t items) -> void
+    {
+        auto spsc = items_per_second<glados::pipeline::spsc_queue<tile<Size>>>(items);
+        auto blocking = items_per_second<glados::pipeline::blocking_queue<tile<Size>>>(items);
+
+        std::printf("%8zu %16.2f %16.2f %12.2f\n", Size, spsc / 1e6, blocking / 1e6, spsc * Size / 1e9);
+    }
+}
+
+auto main() -> int
+{
+    constexpr auto items = std::size_t{2000000};
+
+    std::printf("%8s %16s %16s %12s\n", "bytes", "spsc [M/s]", "blocking [M/s]", "spsc [GB/s]");
+    report<8>(items);
+    report<64>(items);
+    report<256>(items);
+    report<1024>(items);
+    report<4096>(items / 4);
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Measures the per-task overhead of task_pipeline with fresh threads per task (std::async), with a
+ * persistent thread_pool and with overlapped tasks. Every task pushes a handful of elements through
+ * three stages.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <glados/generic/thread_pool.h>
+#include <glados/pipeline/pipeline.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    class producer
+    {
+        public:
+            using input_type = void;
+            using output_type = int;
+
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+            auto assign_task(int task) -> void { count_ = task; }
+
+            auto run() -> void
+            {
+                for(auto i = 0; i < count_; ++i)
+                    output_(i);
+            }
+
+        private:
+            int count_ = 0;
+            std::function<void(output_type)> output_;
+    };
+
+    class worker
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                while(true)
+                    output_(input_() + 1);
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    class consumer
+    {
+        public:
+            using input_type = int;
+            using output_type = void;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                while(true)
+                    input_();
+            }
+
+        private:
+            std::function<input_type()> input_;
+    };
+
+    auto run_tasks(glados::generic::thread_pool* pool, int tasks, int items, std::size_t in_flight) -> double
+    {
+        auto queue = std::queue<int>{};
+        for(auto t = 0; t < tasks; ++t)
+            queue.push(items);
+        glados::pipeline::task_queue<int> q{queue};
+
+        auto start = clock_type::now();
+
+        auto p = glados::pipeline::task_pipeline<int>{&q, pool, in_flight};
+        auto src = p.make_stage<producer>();
+        auto wrk = p.make_stage<worker>();
+        auto snk = p.make_stage<consumer>();
+        p.connect(src, wrk, snk);
+        p.run(src, wrk, snk);
+        p.wait();
+
+        auto us = std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+        return us / tasks;
+    }
+}
+
+auto main() -> int
+{
+    constexpr auto tasks = 2000;
+    constexpr auto items = 16;
+
+    glados::generic::thread_pool pool{3};
+
+    std::printf("%-20s %14s\n", "executor", "per task [us]");
+    std::printf("%-20s %14.1f\n", "std::async", run_tasks(nullptr, tasks, items, 1));
+    std::printf("%-20s %14.1f\n", "thread_pool", run_tasks(&pool, tasks, items, 1));
+    std::printf("%-20s %14.1f\n", "overlapped (4)", run_tasks(&pool, tasks, items, 4));
+    return 0;
+}
@@ -23,17 +23,49 @@
 #ifndef GLADOS_BITS_POOL_ALLOCATOR_H_
 #define GLADOS_BITS_POOL_ALLOCATOR_H_
 
-#include <atomic>
-#include <forward_list>
+#include <chrono>
 #include <functional>
-#include <thread>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
 #include <glados/bits/memory_layout.h>
+#include <glados/bits/pool_buckets.h>
+#include <glados/bits/pool_home.h>
+#include <glados/bits/pool_limit.h>
+#include <glados/bits/pool_stats.h>
 
 namespace glados
 {
+    /*
+     * Recycles the blocks of InternalAlloc. Blocks are kept in one bucket per requested shape; if
+     * the bucket of a shape is empty, a free block of the smallest shape that is at least as large
+     * in every dimension is handed out before InternalAlloc is asked for a new one. Such a block is
+     * recorded until deallocate() gets it back with the smaller shape; smart pointers keep the
+     * shape of the bucket instead. deallocate() may omit the shape while the pool serves a single
+     * one. Otherwise a block without its shape goes straight back to InternalAlloc and its bytes
+     * stay counted in stats(). deallocate() never throws; if the host runs out of memory for the
+     * bookkeeping of the free lists, the block goes straight back to InternalAlloc.
+     *
+     * With a limit, allocate() blocks while limit blocks are handed out. try_allocate() and
+     * allocate_for() return nullptr instead or after the timeout, respectively.
+     *
+     * A manual pool leaves its blocks alone when it is destroyed, they have to be release()d
+     * before. An owning pool releases its free blocks on destruction; blocks which are still
+     * held by smart pointers go straight back to InternalAlloc when they are returned later.
+     * Raw blocks must come back before an owning pool is destroyed.
+     *
+     * stats() counts the blocks and bytes the pool holds and how often it had to ask InternalAlloc
+     * or wait for the limit. The peak of blocks in use needs a shared counter, which only runs
+     * with a limit or after track_in_use(). A shutdown report receives the final stats, blocks
+     * still in use at that point are leaked by a manual pool.
+     */
+    enum class pool_ownership
+    {
+        manual,
+        owning
+    };
+
     template <class T, memory_layout ml, class InternalAlloc, class = typename std::enable_if<(ml == InternalAlloc::mem_layout)>::type>
     class pool_allocator {};
 
@@ -55,7 +87,8 @@ namespace glados
             using propagate_on_container_move_assignment = std::true_type;
             using propagate_on_container_swap = std::true_type;
             using is_always_equal = std::true_type;
-            using smart_pointer = typename InternalAlloc::template smart_pointer<std::function<void(T*)>>;
+            using deleter_type = detail::pool_deleter<detail::pool_home<pool_allocator, InternalAlloc>, pointer, 1>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
 
             template <class U>
             struct rebind
@@ -64,38 +97,44 @@ namespace glados
             };
 
         public:
-            pool_allocator() = default;
+            pool_allocator() : pool_allocator(0) {}
 
-            pool_allocator(size_type limit) noexcept
-            : alloc_{}, list_{}, n_{}, limit_{limit}, current_{0}
+            pool_allocator(size_type limit, pool_ownership ownership = pool_ownership::manual)
+            : alloc_{}, buckets_{}, limit_{limit}
+            , home_{new home_type{this, ownership == pool_ownership::owning}}
             {}
 
             pool_allocator(pool_allocator&& other) noexcept
-            : alloc_{std::move(other.alloc_)}, list_{std::move(other.list_)}
-            , n_{other.n_}, limit_{other.limit_}, current_{other.current_.load()}, moved_{other.moved_}
+            : alloc_{std::move(other.alloc_)}, buckets_{std::move(other.buckets_)}
+            , limit_{std::move(other.limit_)}, home_{other.home_}, moved_{other.moved_}
+            , counters_{std::move(other.counters_)}, report_{std::move(other.report_)}
             {
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
+                if(home_ != nullptr)
+                    home_->move_to(this);
 
+                other.home_ = nullptr;
                 other.moved_ = true;
             }
 
             auto operator=(pool_allocator&& other) noexcept -> pool_allocator&
             {
+                if(this == &other)
+                    return *this;
+
+                // *this ends like a destroyed pool before it takes over other's blocks
+                shut_down();
+
                 alloc_ = std::move(other.alloc_);
-                list_ = std::move(other.list_);
-                n_ = other.n_;
-                limit_ = other.limit_;
-                current_ = other.current_.load();
+                buckets_ = std::move(other.buckets_);
+                limit_ = std::move(other.limit_);
+                home_ = other.home_;
                 moved_ = other.moved_;
+                counters_ = std::move(other.counters_);
+                report_ = std::move(other.report_);
+                if(home_ != nullptr)
+                    home_->move_to(this);
 
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
+                other.home_ = nullptr;
                 other.moved_ = true;
 
                 return *this;
@@ -106,7 +145,7 @@ namespace glados
 
             ~pool_allocator()
             {
-                // pool_allocator's contents have to be released manually
+                shut_down();
             }
 
             auto allocate(size_type n) -> pointer
@@ -114,77 +153,204 @@ namespace glados
                 if(moved_)
                     return pointer{nullptr};
 
-                if(n_ == 0)
-                    n_ = n;
+                limit_.acquire();
+                return take(n);
+            }
 
-                auto ret = static_cast<pointer>(nullptr);
+            auto try_allocate(size_type n) -> pointer
+            {
+                if(moved_ || !limit_.try_acquire())
+                    return pointer{nullptr};
 
-                if(limit_ != 0)
-                {
-                    while(current_.load() >= limit_)
-                        std::this_thread::yield();
-                }
+                return take(n);
+            }
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+            template <class Rep, class Period>
+            auto allocate_for(size_type n, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+            {
+                if(moved_ || !limit_.acquire_for(timeout))
+                    return pointer{nullptr};
+
+                return take(n);
+            }
+
+            auto allocate_smart(size_type n) -> smart_pointer
+            {
+                if(moved_)
+                    return smart_pointer{};
+
+                // the deleter holds the shape of the block's bucket, so a lent block needs no record
+                limit_.acquire();
+                auto from = static_cast<bucket_type*>(nullptr);
+                auto p = take(n, from);
+                return smart_pointer{p, deleter_type{home_, from->shape[0]}};
+            }
+
+            auto deallocate(pointer p, size_type n = 0) noexcept -> void
+            {
+                if(moved_ || (p == nullptr))
+                    return;
 
-                if(list_.empty())
-                    ret = alloc_.allocate(n_);
-                else
+                // a lent block comes back with the smaller shape it was requested with
+                auto bucket = buckets_.owner(p);
+                if(bucket == nullptr)
+                    bucket = (n == 0) ? buckets_.only() : buckets_.find({{n}});
+                put_back(p, bucket, n);
+            }
+
+            auto release() noexcept -> void
+            {
+                if(moved_)
+                    return;
+
+                using shape_type = typename detail::pool_buckets<pointer, 1>::shape_type;
+                buckets_.drain([this](const pointer& p, const shape_type& s) {
+                    alloc_.deallocate(p, s[0]);
+                    counters_.released(s[0] * sizeof(T));
+                });
+            }
+
+            // adds count free blocks of this shape, so the first allocations don't reach InternalAlloc
+            auto reserve(size_type count, size_type n) -> void
+            {
+                if(moved_)
+                    return;
+
+                auto&& bucket = buckets_.get({{n}});
+                for(auto i = size_type{0}; i < count; ++i)
                 {
-                    ret = std::move(list_.front());
-                    list_.pop_front();
+                    bucket.list.push_shared(alloc_.allocate(n));
+                    counters_.reserved(n * sizeof(T));
                 }
+            }
 
-                ++current_;
-                lock_.clear(std::memory_order_release);
+            auto stats() const -> pool_stats
+            {
+                auto traffic = buckets_.traffic();
+                return counters_.snapshot(traffic.pops, traffic.pushes, limit_);
+            }
 
-                return ret;
+            // counts the blocks in use on a shared counter without a limit, too; call before the first allocation
+            auto track_in_use() noexcept -> void
+            {
+                limit_.track();
             }
 
-            auto allocate_smart(size_type n) -> smart_pointer
+            // called with the final stats() when the pool is destroyed, e.g. to report leaked blocks
+            auto set_shutdown_report(std::function<void(const pool_stats&)> report) -> void
             {
-                return smart_pointer{allocate(n), [this](T* ptr){ this->deallocate(ptr); }};
+                report_ = std::move(report);
             }
 
-            auto deallocate(pointer p, size_type = 0) noexcept -> void
+        private:
+            using home_type = detail::pool_home<pool_allocator, InternalAlloc>;
+            using bucket_list = detail::pool_buckets<pointer, 1>;
+            using bucket_type = typename bucket_list::bucket;
+
+            friend home_type;
+
+            auto shut_down() noexcept -> void
             {
-                if(moved_ || (p == nullptr))
+                if(!moved_ && report_)
+                    report_(stats());
+
+                // a manual pool_allocator's contents have to be released manually
+                auto owning = (home_ != nullptr) && home_->owning();
+                leave_home();
+                if(owning)
+                    release();
+            }
+
+            // an owning pool's deleters keep the home alive but stop touching the pool
+            auto leave_home() noexcept -> void
+            {
+                if(home_ == nullptr)
                     return;
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+                if(home_->owning())
+                    home_->close();
 
-                list_.push_front(p);
-                --current_;
-                lock_.clear(std::memory_order_release);
+                home_->drop();
+                home_ = nullptr;
             }
 
-            auto release() noexcept -> void
+            // the deleters of smart pointers hold the shape of the block's bucket, their blocks are never lent
+            auto recycle(pointer p, size_type n) noexcept -> void
             {
-                if(moved_)
+                if(moved_ || (p == nullptr))
                     return;
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+                put_back(p, buckets_.find({{n}}), n);
+            }
 
-                for(auto&& p : list_)
-                    alloc_.deallocate(p, n_);
+            auto put_back(pointer p, bucket_type* bucket, size_type n) noexcept -> void
+            {
+                // the block's shape is unknown or was never served by this pool
+                if(bucket == nullptr)
+                {
+                    alloc_.deallocate(p, n);
+                    counters_.returned_directly(n * sizeof(T));
+                }
+                else if(!bucket->list.push(p))
+                {
+                    auto&& s = bucket->shape;
+                    alloc_.deallocate(p, s[0]);
+                    counters_.returned_directly(s[0] * sizeof(T));
+                }
+
+                limit_.release();
+            }
 
-                n_ = 0;
-                current_.store(0);
+            // from is set to the bucket the block belongs to, best_fit() may take it from a larger shape's
+            auto take(size_type n, bucket_type*& from) -> pointer
+            {
+                auto ret = static_cast<pointer>(nullptr);
+                try
+                {
+                    auto&& bucket = buckets_.get({{n}});
+                    from = &bucket;
+                    if(bucket.list.pop(ret) || buckets_.best_fit({{n}}, ret, from))
+                        return ret;
+
+                    auto p = alloc_.allocate(n);
+                    counters_.missed(n * sizeof(T));
+                    return p;
+                }
+                catch(...)
+                {
+                    limit_.release();
+                    throw;
+                }
+            }
 
-                lock_.clear(std::memory_order_release);
+            // deallocate() gets the requested shape back, so a block of a larger shape is lent
+            auto take(size_type n) -> pointer
+            {
+                auto from = static_cast<bucket_type*>(nullptr);
+                auto p = take(n, from);
+                if(!bucket_list::same(from->shape, {{n}}))
+                {
+                    try
+                    {
+                        buckets_.lend(p, *from);
+                    }
+                    catch(...)
+                    {
+                        limit_.release();
+                        throw;
+                    }
+                }
+                return p;
             }
 
         private:
             InternalAlloc alloc_;
-            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
-            std::forward_list<pointer> list_;
-            size_type n_;
-            size_type limit_;
-            std::atomic_size_t current_;
+            bucket_list buckets_;
+            detail::pool_limit limit_;
+            home_type* home_;
             bool moved_ = false;
+            detail::pool_counters counters_;
+            std::function<void(const pool_stats&)> report_;
     };
 
     /* 2D specialization */
@@ -205,7 +371,8 @@ namespace glados
             using propagate_on_container_move_assignment = std::true_type;
             using propagate_on_container_swap = std::true_type;
             using is_always_equal = std::true_type;
-            using smart_pointer = typename InternalAlloc::template smart_pointer<std::function<void(T*)>>;
+            using deleter_type = detail::pool_deleter<detail::pool_home<pool_allocator, InternalAlloc>, pointer, 2>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
 
             template <class U>
             struct rebind
@@ -214,38 +381,43 @@ namespace glados
             };
 
         public:
-            pool_allocator() = default;
+            pool_allocator() : pool_allocator(0) {}
 
-            pool_allocator(size_type limit)
-            : alloc_{}, list_{}, x_{0}, y_{0}, limit_{limit}, current_{0}
+            pool_allocator(size_type limit, pool_ownership ownership = pool_ownership::manual)
+            : alloc_{}, buckets_{}, limit_{limit}
+            , home_{new home_type{this, ownership == pool_ownership::owning}}
             {}
 
             pool_allocator(pool_allocator&& other) noexcept
-            : alloc_{std::move(other.alloc_)}, list_{std::move(other.list_)}
-            , x_{other.x_}, y_{other.y_}, limit_{other.limit_}, current_{other.current_.load()}, moved_{other.moved_}
+            : alloc_{std::move(other.alloc_)}, buckets_{std::move(other.buckets_)}
+            , limit_{std::move(other.limit_)}, home_{other.home_}, moved_{other.moved_}
+            , counters_{std::move(other.counters_)}, report_{std::move(other.report_)}
             {
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
+                if(home_ != nullptr)
+                    home_->move_to(this);
 
+                other.home_ = nullptr;
                 other.moved_ = true;
             }
 
             auto operator=(pool_allocator&& other) noexcept -> pool_allocator&
             {
+                if(this == &other)
+                    return *this;
+
+                // *this ends like a destroyed pool before it takes over other's blocks
+                shut_down();
+
                 alloc_ = std::move(other.alloc_);
-                list_ = std::move(other.list_);
-                x_ = other.x_;
-                y_ = other.y_;
-                limit_ = other.limit_;
-                current_ = other.current_.load();
+                buckets_ = std::move(other.buckets_);
+                limit_ = std::move(other.limit_);
+                home_ = other.home_;
                 moved_ = other.moved_;
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
+                counters_ = std::move(other.counters_);
+                report_ = std::move(other.report_);
+                if(home_ != nullptr)
+                    home_->move_to(this);
+                other.home_ = nullptr;
                 other.moved_ = true;
 
                 return *this;
@@ -256,7 +428,7 @@ namespace glados
 
             ~pool_allocator()
             {
-                // pool_allocator's contents have to be released manually
+                shut_down();
             }
 
             auto allocate(size_type x, size_type y) -> pointer
@@ -264,83 +436,205 @@ namespace glados
                 if(moved_)
                     return pointer{nullptr};
 
-                if(x_ == 0)
-                    x_ = x;
+                limit_.acquire();
+                return take(x, y);
+            }
+
+            auto try_allocate(size_type x, size_type y) -> pointer
+            {
+                if(moved_ || !limit_.try_acquire())
+                    return pointer{nullptr};
+
+                return take(x, y);
+            }
 
-                if(y_ == 0)
-                    y_ = y;
+            template <class Rep, class Period>
+            auto allocate_for(size_type x, size_type y, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+            {
+                if(moved_ || !limit_.acquire_for(timeout))
+                    return pointer{nullptr};
 
-                auto ret = static_cast<pointer>(nullptr);
+                return take(x, y);
+            }
 
-                if(limit_ != 0)
-                {
-                    while(current_.load() >= limit_)
-                        std::this_thread::yield();
-                }
+            auto allocate_smart(size_type x, size_type y) -> smart_pointer
+            {
+                if(moved_)
+                    return smart_pointer{};
+
+                // the deleter holds the shape of the block's bucket, so a lent block needs no record
+                limit_.acquire();
+                auto from = static_cast<bucket_type*>(nullptr);
+                auto p = take(x, y, from);
+                auto&& s = from->shape;
+                return smart_pointer{p, deleter_type{home_, p, s[0], s[1]}};
+            }
+
+            auto deallocate(pointer p, size_type x = 0, size_type y = 0) noexcept -> void
+            {
+                if(moved_ || (p == nullptr))
+                    return;
+
+                // a lent block comes back with the smaller shape it was requested with
+                auto bucket = buckets_.owner(p);
+                if(bucket == nullptr)
+                    bucket = (x == 0) ? buckets_.only() : buckets_.find({{x, y}});
+                put_back(p, bucket, x, y);
+            }
+
+            auto release() noexcept -> void
+            {
+                if(moved_) // the allocator becomes invalid once moved from
+                    return;
+
+                using shape_type = typename detail::pool_buckets<pointer, 2>::shape_type;
+                buckets_.drain([this](const pointer& p, const shape_type& s) {
+                    alloc_.deallocate(p, s[0], s[1]);
+                    counters_.released(s[0] * s[1] * sizeof(T));
+                });
+            }
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+            // adds count free blocks of this shape, so the first allocations don't reach InternalAlloc
+            auto reserve(size_type count, size_type x, size_type y) -> void
+            {
+                if(moved_)
+                    return;
 
-                if(list_.empty())
-                    ret = alloc_.allocate(x_, y_);
-                else
+                auto&& bucket = buckets_.get({{x, y}});
+                for(auto i = size_type{0}; i < count; ++i)
                 {
-                    ret = std::move(list_.front());
-                    list_.pop_front();
+                    bucket.list.push_shared(alloc_.allocate(x, y));
+                    counters_.reserved(x * y * sizeof(T));
                 }
+            }
 
-                ++current_;
-                lock_.clear(std::memory_order_release);
+            auto stats() const -> pool_stats
+            {
+                auto traffic = buckets_.traffic();
+                return counters_.snapshot(traffic.pops, traffic.pushes, limit_);
+            }
 
-                return ret;
+            // counts the blocks in use on a shared counter without a limit, too; call before the first allocation
+            auto track_in_use() noexcept -> void
+            {
+                limit_.track();
             }
 
-            auto allocate_smart(size_type x, size_type y) -> smart_pointer
+            // called with the final stats() when the pool is destroyed, e.g. to report leaked blocks
+            auto set_shutdown_report(std::function<void(const pool_stats&)> report) -> void
             {
-                auto p = allocate(x, y);
-                return smart_pointer{p, [this, p](T*){ this->deallocate(p); }};
+                report_ = std::move(report);
             }
 
-            auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
+        private:
+            using home_type = detail::pool_home<pool_allocator, InternalAlloc>;
+            using bucket_list = detail::pool_buckets<pointer, 2>;
+            using bucket_type = typename bucket_list::bucket;
+
+            friend home_type;
+
+            auto shut_down() noexcept -> void
             {
-                if(moved_ || (p == nullptr))
+                if(!moved_ && report_)
+                    report_(stats());
+
+                // a manual pool_allocator's contents have to be released manually
+                auto owning = (home_ != nullptr) && home_->owning();
+                leave_home();
+                if(owning)
+                    release();
+            }
+
+            // an owning pool's deleters keep the home alive but stop touching the pool
+            auto leave_home() noexcept -> void
+            {
+                if(home_ == nullptr)
                     return;
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+                if(home_->owning())
+                    home_->close();
 
-                list_.push_front(p);
-                --current_;
-                lock_.clear(std::memory_order_release);
+                home_->drop();
+                home_ = nullptr;
             }
 
-            auto release() noexcept -> void
+            // the deleters of smart pointers hold the shape of the block's bucket, their blocks are never lent
+            auto recycle(pointer p, size_type x, size_type y) noexcept -> void
             {
-                if(moved_) // the allocator becomes invalid once moved from
+                if(moved_ || (p == nullptr))
                     return;
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+                put_back(p, buckets_.find({{x, y}}), x, y);
+            }
 
-                for(auto&& p : list_)
-                    alloc_.deallocate(p, x_, y_);
+            auto put_back(pointer p, bucket_type* bucket, size_type x, size_type y) noexcept -> void
+            {
+                // the block's shape is unknown or was never served by this pool
+                if(bucket == nullptr)
+                {
+                    alloc_.deallocate(p, x, y);
+                    counters_.returned_directly(x * y * sizeof(T));
+                }
+                else if(!bucket->list.push(p))
+                {
+                    auto&& s = bucket->shape;
+                    alloc_.deallocate(p, s[0], s[1]);
+                    counters_.returned_directly(s[0] * s[1] * sizeof(T));
+                }
 
-                x_ = 0;
-                y_ = 0;
-                current_.store(0);
+                limit_.release();
+            }
 
-                lock_.clear(std::memory_order_release);
+            // from is set to the bucket the block belongs to, best_fit() may take it from a larger shape's
+            auto take(size_type x, size_type y, bucket_type*& from) -> pointer
+            {
+                auto ret = static_cast<pointer>(nullptr);
+                try
+                {
+                    auto&& bucket = buckets_.get({{x, y}});
+                    from = &bucket;
+                    if(bucket.list.pop(ret) || buckets_.best_fit({{x, y}}, ret, from))
+                        return ret;
+
+                    auto p = alloc_.allocate(x, y);
+                    counters_.missed(x * y * sizeof(T));
+                    return p;
+                }
+                catch(...)
+                {
+                    limit_.release();
+                    throw;
+                }
+            }
+
+            // deallocate() gets the requested shape back, so a block of a larger shape is lent
+            auto take(size_type x, size_type y) -> pointer
+            {
+                auto from = static_cast<bucket_type*>(nullptr);
+                auto p = take(x, y, from);
+                if(!bucket_list::same(from->shape, {{x, y}}))
+                {
+                    try
+                    {
+                        buckets_.lend(p, *from);
+                    }
+                    catch(...)
+                    {
+                        limit_.release();
+                        throw;
+                    }
+                }
+                return p;
             }
 
         private:
             InternalAlloc alloc_;
-            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
-            std::forward_list<pointer> list_;
-            size_type x_;
-            size_type y_;
-            size_type limit_;
-            std::atomic_size_t current_;
+            bucket_list buckets_;
+            detail::pool_limit limit_;
+            home_type* home_;
             bool moved_ = false;
+            detail::pool_counters counters_;
+            std::function<void(const pool_stats&)> report_;
     };
 
     /* 3D specialization */
@@ -361,7 +655,8 @@ namespace glados
             using const_pointer = typename InternalAlloc::const_pointer;
             using size_type = typename InternalAlloc::size_type;
             using difference_type = typename InternalAlloc::difference_type;
-            using smart_pointer = typename InternalAlloc::template smart_pointer<std::function<void(T*)>>;
+            using deleter_type = detail::pool_deleter<detail::pool_home<pool_allocator, InternalAlloc>, pointer, 3>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
 
             template <class U>
             struct rebind
@@ -370,39 +665,43 @@ namespace glados
             };
 
         public:
-            pool_allocator() = default;
+            pool_allocator() : pool_allocator(0) {}
 
-            pool_allocator(size_type limit)
-            : alloc_{}, list_{}, x_{}, y_{}, z_{}, limit_{limit}, current_{0}
+            pool_allocator(size_type limit, pool_ownership ownership = pool_ownership::manual)
+            : alloc_{}, buckets_{}, limit_{limit}
+            , home_{new home_type{this, ownership == pool_ownership::owning}}
             {}
 
             pool_allocator(pool_allocator&& other) noexcept
-            : alloc_{std::move(other.alloc_)}, list_{std::move(other.list_)}
-            , x_{other.x_}, y_{other.y_}, z_{other.z_}, limit_{other.limit_}, current_{other.current_.load()}, moved_{other.moved_}
+            : alloc_{std::move(other.alloc_)}, buckets_{std::move(other.buckets_)}
+            , limit_{std::move(other.limit_)}, home_{other.home_}, moved_{other.moved_}
+            , counters_{std::move(other.counters_)}, report_{std::move(other.report_)}
             {
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
+                if(home_ != nullptr)
+                    home_->move_to(this);
 
+                other.home_ = nullptr;
                 other.moved_ = true;
             }
 
             auto operator=(pool_allocator&& other) noexcept -> pool_allocator&
             {
+                if(this == &other)
+                    return *this;
+
+                // *this ends like a destroyed pool before it takes over other's blocks
+                shut_down();
+
                 alloc_ = std::move(other.alloc_);
-                list_ = std::move(other.list_);
-                x_ = other.x_;
-                y_ = other.y_;
-                z_ = other.z_;
-                limit_ = other.limit_;
-                current_ = other.current_.load();
+                buckets_ = std::move(other.buckets_);
+                limit_ = std::move(other.limit_);
+                home_ = other.home_;
                 moved_ = other.moved_;
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
+                counters_ = std::move(other.counters_);
+                report_ = std::move(other.report_);
+                if(home_ != nullptr)
+                    home_->move_to(this);
+                other.home_ = nullptr;
                 other.moved_ = true;
 
                 return *this;
@@ -413,7 +712,7 @@ namespace glados
 
             ~pool_allocator()
             {
-                // pool_allocator's contents have to be released manually
+                shut_down();
             }
 
             auto allocate(size_type x, size_type y, size_type z) -> pointer
@@ -421,86 +720,205 @@ namespace glados
                 if(moved_)
                     return pointer{nullptr};
 
-                if(x_ == 0)
-                    x_ = x;
-                if(y_ == 0)
-                    y_ = y;
-                if(z_ == 0)
-                    z_ = z;
+                limit_.acquire();
+                return take(x, y, z);
+            }
+
+            auto try_allocate(size_type x, size_type y, size_type z) -> pointer
+            {
+                if(moved_ || !limit_.try_acquire())
+                    return pointer{nullptr};
 
-                if(limit_ != 0)
-                {
-                    while(current_.load() >= limit_)
-                        std::this_thread::yield();
-                }
+                return take(x, y, z);
+            }
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+            template <class Rep, class Period>
+            auto allocate_for(size_type x, size_type y, size_type z, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+            {
+                if(moved_ || !limit_.acquire_for(timeout))
+                    return pointer{nullptr};
 
-                auto ret = static_cast<pointer>(nullptr);
+                return take(x, y, z);
+            }
 
-                if(list_.empty())
-                    ret = alloc_.allocate(x_, y_, z_);
-                else
+            auto allocate_smart(size_type x, size_type y, size_type z) -> smart_pointer
+            {
+                if(moved_)
+                    return smart_pointer{};
+
+                // the deleter holds the shape of the block's bucket, so a lent block needs no record
+                limit_.acquire();
+                auto from = static_cast<bucket_type*>(nullptr);
+                auto p = take(x, y, z, from);
+                auto&& s = from->shape;
+                return smart_pointer{p, deleter_type{home_, p, s[0], s[1], s[2]}};
+            }
+
+            auto deallocate(pointer p, size_type x = 0, size_type y = 0, size_type z = 0) noexcept -> void
+            {
+                if(moved_ || (p == nullptr))
+                    return;
+
+                // a lent block comes back with the smaller shape it was requested with
+                auto bucket = buckets_.owner(p);
+                if(bucket == nullptr)
+                    bucket = (x == 0) ? buckets_.only() : buckets_.find({{x, y, z}});
+                put_back(p, bucket, x, y, z);
+            }
+
+            auto release() noexcept -> void
+            {
+                if(moved_) // the allocator becomes invalid once moved from
+                    return;
+
+                using shape_type = typename detail::pool_buckets<pointer, 3>::shape_type;
+                buckets_.drain([this](const pointer& p, const shape_type& s) {
+                    alloc_.deallocate(p, s[0], s[1], s[2]);
+                    counters_.released(s[0] * s[1] * s[2] * sizeof(T));
+                });
+            }
+
+            // adds count free blocks of this shape, so the first allocations don't reach InternalAlloc
+            auto reserve(size_type count, size_type x, size_type y, size_type z) -> void
+            {
+                if(moved_)
+                    return;
+
+                auto&& bucket = buckets_.get({{x, y, z}});
+                for(auto i = size_type{0}; i < count; ++i)
                 {
-                    ret = std::move(list_.front());
-                    list_.pop_front();
+                    bucket.list.push_shared(alloc_.allocate(x, y, z));
+                    counters_.reserved(x * y * z * sizeof(T));
                 }
+            }
 
-                ++current_;
-                lock_.clear(std::memory_order_release);
+            auto stats() const -> pool_stats
+            {
+                auto traffic = buckets_.traffic();
+                return counters_.snapshot(traffic.pops, traffic.pushes, limit_);
+            }
 
-                return ret;
+            // counts the blocks in use on a shared counter without a limit, too; call before the first allocation
+            auto track_in_use() noexcept -> void
+            {
+                limit_.track();
             }
 
-            auto allocate_smart(size_type x, size_type y, size_type z) -> smart_pointer
+            // called with the final stats() when the pool is destroyed, e.g. to report leaked blocks
+            auto set_shutdown_report(std::function<void(const pool_stats&)> report) -> void
+            {
+                report_ = std::move(report);
+            }
+
+        private:
+            using home_type = detail::pool_home<pool_allocator, InternalAlloc>;
+            using bucket_list = detail::pool_buckets<pointer, 3>;
+            using bucket_type = typename bucket_list::bucket;
+
+            friend home_type;
+
+            auto shut_down() noexcept -> void
             {
-                auto p = allocate(x, y, z);
-                return smart_pointer{p, [this, p](T*){ this->deallocate(p); }};
+                if(!moved_ && report_)
+                    report_(stats());
+
+                // a manual pool_allocator's contents have to be released manually
+                auto owning = (home_ != nullptr) && home_->owning();
+                leave_home();
+                if(owning)
+                    release();
             }
 
-            auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+            // an owning pool's deleters keep the home alive but stop touching the pool
+            auto leave_home() noexcept -> void
             {
-                if(moved_ || (p == nullptr))
+                if(home_ == nullptr)
                     return;
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+                if(home_->owning())
+                    home_->close();
 
-                list_.push_front(p);
-                --current_;
-                lock_.clear(std::memory_order_release);
+                home_->drop();
+                home_ = nullptr;
             }
 
-            auto release() noexcept -> void
+            // the deleters of smart pointers hold the shape of the block's bucket, their blocks are never lent
+            auto recycle(pointer p, size_type x, size_type y, size_type z) noexcept -> void
             {
-                if(moved_) // the allocator becomes invalid once moved from
+                if(moved_ || (p == nullptr))
                     return;
 
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
+                put_back(p, buckets_.find({{x, y, z}}), x, y, z);
+            }
+
+            auto put_back(pointer p, bucket_type* bucket, size_type x, size_type y, size_type z) noexcept -> void
+            {
+                // the block's shape is unknown or was never served by this pool
+                if(bucket == nullptr)
+                {
+                    alloc_.deallocate(p, x, y, z);
+                    counters_.returned_directly(x * y * z * sizeof(T));
+                }
+                else if(!bucket->list.push(p))
+                {
+                    auto&& s = bucket->shape;
+                    alloc_.deallocate(p, s[0], s[1], s[2]);
+                    counters_.returned_directly(s[0] * s[1] * s[2] * sizeof(T));
+                }
 
-                for(auto&& p : list_)
-                    alloc_.deallocate(p, x_, y_, z_);
+                limit_.release();
+            }
 
-                x_ = 0;
-                y_ = 0;
-                z_ = 0;
-                current_.store(0);
+            // from is set to the bucket the block belongs to, best_fit() may take it from a larger shape's
+            auto take(size_type x, size_type y, size_type z, bucket_type*& from) -> pointer
+            {
+                auto ret = static_cast<pointer>(nullptr);
+                try
+                {
+                    auto&& bucket = buckets_.get({{x, y, z}});
+                    from = &bucket;
+                    if(bucket.list.pop(ret) || buckets_.best_fit({{x, y, z}}, ret, from))
+                        return ret;
+
+                    auto p = alloc_.allocate(x, y, z);
+                    counters_.missed(x * y * z * sizeof(T));
+                    return p;
+                }
+                catch(...)
+                {
+                    limit_.release();
+                    throw;
+                }
+            }
 
-                lock_.clear(std::memory_order_release);
+            // deallocate() gets the requested shape back, so a block of a larger shape is lent
+            auto take(size_type x, size_type y, size_type z) -> pointer
+            {
+                auto from = static_cast<bucket_type*>(nullptr);
+                auto p = take(x, y, z, from);
+                if(!bucket_list::same(from->shape, {{x, y, z}}))
+                {
+                    try
+                    {
+                        buckets_.lend(p, *from);
+                    }
+                    catch(...)
+                    {
+                        limit_.release();
+                        throw;
+                    }
+                }
+                return p;
             }
 
         private:
             InternalAlloc alloc_;
-            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
-            std::forward_list<pointer> list_;
-            size_type x_;
-            size_type y_;
-            size_type z_;
-            size_type limit_;
-            std::atomic_size_t current_;
+            bucket_list buckets_;
+            detail::pool_limit limit_;
+            home_type* home_;
             bool moved_ = false;
+            detail::pool_counters counters_;
+            std::function<void(const pool_stats&)> report_;
     };
 }
 
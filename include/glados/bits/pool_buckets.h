@@ -0,0 +1,287 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_BUCKETS_H_
+#define GLADOS_BITS_POOL_BUCKETS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <glados/bits/pitched_ptr.h>
+#include <glados/bits/pool_free_list.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * The free lists of a pool_allocator, one bucket per requested shape. Buckets are only ever
+         * appended to a list, so looking one up is a lock-free walk over the buckets published so
+         * far. A block best_fit() takes from a larger bucket comes back with the smaller shape it
+         * was requested with, unless the caller keeps the shape of its bucket; lend() records the
+         * bucket of such a block until owner() takes it back. Blocks of their own bucket are never
+         * recorded.
+         */
+        template <class Pointer, std::size_t Dims>
+        class pool_buckets
+        {
+            public:
+                using shape_type = std::array<std::size_t, Dims>;
+
+                struct bucket
+                {
+                    bucket(const shape_type& s) : shape(s) {}
+
+                    shape_type shape;
+                    pool_free_list<Pointer> list;
+                    std::atomic<bucket*> next{nullptr};
+                };
+
+            public:
+                pool_buckets() : state_{new state{}} {}
+
+                pool_buckets(pool_buckets&&) noexcept = default;
+                auto operator=(pool_buckets&&) noexcept -> pool_buckets& = default;
+
+                // returns nullptr if no block of this shape was requested yet
+                auto find(const shape_type& shape) const noexcept -> bucket*
+                {
+                    for(auto b = state_->head.load(std::memory_order_acquire); b != nullptr; b = b->next.load(std::memory_order_acquire))
+                    {
+                        if(same(b->shape, shape))
+                            return b;
+                    }
+                    return nullptr;
+                }
+
+                auto get(const shape_type& shape) -> bucket&
+                {
+                    auto b = find(shape);
+                    return (b != nullptr) ? *b : add(shape);
+                }
+
+                // the bucket of every block while there is a single one, nullptr otherwise
+                auto only() const noexcept -> bucket*
+                {
+                    return (state_->size.load(std::memory_order_acquire) == 1) ? state_->head.load(std::memory_order_acquire) : nullptr;
+                }
+
+                /*
+                 * Takes a free block from the smallest bucket whose blocks are at least as large as
+                 * shape in every dimension and sets from to that bucket. Returns false if there is
+                 * none.
+                 */
+                auto best_fit(const shape_type& shape, Pointer& p, bucket*& from) -> bool
+                {
+                    // buckets are tried by increasing volume, ties in list order
+                    auto last = static_cast<bucket*>(nullptr);
+                    auto last_i = std::size_t{0};
+                    while(true)
+                    {
+                        auto best = static_cast<bucket*>(nullptr);
+                        auto best_i = std::size_t{0};
+                        auto i = std::size_t{0};
+                        for(auto b = state_->head.load(std::memory_order_acquire); b != nullptr; b = b->next.load(std::memory_order_acquire), ++i)
+                        {
+                            if(!fits(b->shape, shape) || ((last != nullptr) && !before(last, last_i, b, i)))
+                                continue;
+
+                            if((best == nullptr) || before(b, i, best, best_i))
+                            {
+                                best = b;
+                                best_i = i;
+                            }
+                        }
+
+                        if(best == nullptr)
+                            return false;
+
+                        if(best->list.pop(p))
+                        {
+                            from = best;
+                            return true;
+                        }
+
+                        last = best;
+                        last_i = best_i;
+                    }
+                }
+
+                // records that p belongs to b; if that fails, p goes back to b before the exception propagates
+                auto lend(const Pointer& p, bucket& b) -> void
+                {
+                    try
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{state_->lent_mutex};
+                        state_->lent[address(p)] = &b;
+                    }
+                    catch(...)
+                    {
+                        // only lost if the free list is out of host memory, too
+                        static_cast<void>(b.list.push(p));
+                        throw;
+                    }
+                    state_->lent_count.fetch_add(1, std::memory_order_release);
+                }
+
+                // the bucket a lent block belongs to, nullptr for every other block
+                auto owner(const Pointer& p) -> bucket*
+                {
+                    if(state_->lent_count.load(std::memory_order_acquire) == 0)
+                        return nullptr;
+
+                    auto&& lock = std::lock_guard<std::mutex>{state_->lent_mutex};
+                    auto it = state_->lent.find(address(p));
+                    if(it == std::end(state_->lent))
+                        return nullptr;
+
+                    auto b = it->second;
+                    state_->lent.erase(it);
+                    state_->lent_count.fetch_sub(1, std::memory_order_relaxed);
+                    return b;
+                }
+
+                auto traffic() const -> free_list_traffic
+                {
+                    auto ret = free_list_traffic{};
+                    for(auto b = state_->head.load(std::memory_order_acquire); b != nullptr; b = b->next.load(std::memory_order_acquire))
+                    {
+                        auto t = b->list.traffic();
+                        ret.pops += t.pops;
+                        ret.pushes += t.pushes;
+                    }
+                    return ret;
+                }
+
+                // hands every free block and the shape of its bucket to f, must not run concurrently with allocations
+                template <class Func>
+                auto drain(Func f) -> void
+                {
+                    for(auto b = state_->head.load(std::memory_order_acquire); b != nullptr; b = b->next.load(std::memory_order_acquire))
+                        b->list.drain([&](const Pointer& p) { f(p, b->shape); });
+                }
+
+                // std::array's operator== ends up in an out-of-line memcmp
+                static auto same(const shape_type& a, const shape_type& b) noexcept -> bool
+                {
+                    for(auto d = std::size_t{0}; d < Dims; ++d)
+                    {
+                        if(a[d] != b[d])
+                            return false;
+                    }
+                    return true;
+                }
+
+            private:
+                struct state
+                {
+                    state() = default;
+                    state(const state&) = delete;
+                    auto operator=(const state&) -> state& = delete;
+
+                    ~state()
+                    {
+                        auto b = head.load(std::memory_order_relaxed);
+                        while(b != nullptr)
+                        {
+                            auto next = b->next.load(std::memory_order_relaxed);
+                            delete b;
+                            b = next;
+                        }
+                    }
+
+                    std::atomic<bucket*> head{nullptr};
+                    bucket* tail = nullptr; // guarded by mutex
+                    std::atomic<std::size_t> size{0};
+                    std::mutex mutex;
+
+                    std::mutex lent_mutex;
+                    std::unordered_map<const void*, bucket*> lent;
+                    std::atomic<std::size_t> lent_count{0}; // keeps owner() off the lock while nothing is lent
+                };
+
+                template <class T>
+                static auto address(T* p) noexcept -> const void*
+                {
+                    return p;
+                }
+
+                template <class T>
+                static auto address(const pitched_ptr<T>& p) noexcept -> const void*
+                {
+                    return p.ptr();
+                }
+
+                auto add(const shape_type& shape) -> bucket&
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{state_->mutex};
+                    auto b = find(shape);
+                    if(b != nullptr)
+                        return *b;
+
+                    b = new bucket{shape};
+                    if(state_->tail == nullptr)
+                        state_->head.store(b, std::memory_order_release);
+                    else
+                        state_->tail->next.store(b, std::memory_order_release);
+                    state_->tail = b;
+                    state_->size.fetch_add(1, std::memory_order_release);
+                    return *b;
+                }
+
+                // orders buckets by volume, then by their position i in the list
+                static auto before(const bucket* a, std::size_t ai, const bucket* b, std::size_t bi) noexcept -> bool
+                {
+                    auto va = volume(a->shape);
+                    auto vb = volume(b->shape);
+                    return (va < vb) || ((va == vb) && (ai < bi));
+                }
+
+                static auto fits(const shape_type& block, const shape_type& shape) noexcept -> bool
+                {
+                    for(auto d = std::size_t{0}; d < Dims; ++d)
+                    {
+                        if(block[d] < shape[d])
+                            return false;
+                    }
+                    return true;
+                }
+
+                static auto volume(const shape_type& shape) noexcept -> std::size_t
+                {
+                    auto v = std::size_t{1};
+                    for(auto s : shape)
+                        v *= s;
+                    return v;
+                }
+
+            private:
+                std::unique_ptr<state> state_;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_BUCKETS_H_ */
@@ -0,0 +1,510 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_FREE_LIST_H_
+#define GLADOS_BITS_POOL_FREE_LIST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace glados
+{
+    namespace detail
+    {
+        inline auto next_pool_id() noexcept -> std::uint64_t
+        {
+            static std::atomic<std::uint64_t> id{1};
+            return id.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /*
+         * Nodes are addressed by 32 bit indices (0 == none) and live in chunks of doubling size which
+         * are never moved or freed before the store itself, so an index stays valid while other
+         * threads add nodes.
+         */
+        template <class Pointer>
+        class node_store
+        {
+            public:
+                struct node
+                {
+                    Pointer value{nullptr};
+                    std::atomic<std::uint32_t> next{0};
+                };
+
+            public:
+                node_store() noexcept
+                {
+                    for(auto&& c : chunks_)
+                        c.store(nullptr, std::memory_order_relaxed);
+                }
+
+                node_store(const node_store&) = delete;
+                auto operator=(const node_store&) -> node_store& = delete;
+
+                ~node_store()
+                {
+                    for(auto&& c : chunks_)
+                        delete[] c.load(std::memory_order_relaxed);
+                }
+
+                auto operator[](std::uint32_t idx) const noexcept -> node&
+                {
+                    auto j = static_cast<std::size_t>(idx - 1);
+                    auto k = chunk_of(j);
+                    return chunks_[k].load(std::memory_order_acquire)[j - first_chunk * ((std::size_t{1} << k) - 1)];
+                }
+
+                auto make_node() -> std::uint32_t
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    auto j = size_;
+                    auto k = chunk_of(j);
+                    if(chunks_[k].load(std::memory_order_relaxed) == nullptr)
+                        chunks_[k].store(new node[first_chunk << k], std::memory_order_release);
+
+                    ++size_;
+                    return static_cast<std::uint32_t>(j + 1);
+                }
+
+            private:
+                static constexpr auto first_chunk = std::size_t{64};
+                static constexpr auto max_chunks = std::size_t{26}; // 2^32 nodes
+
+                static auto chunk_of(std::size_t j) noexcept -> std::size_t
+                {
+                    auto q = j / first_chunk + 1;
+#if defined(__GNUC__)
+                    return static_cast<std::size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(q)));
+#else
+                    auto k = std::size_t{0};
+                    while(q >>= 1)
+                        ++k;
+                    return k;
+#endif
+                }
+
+            private:
+                std::atomic<node*> chunks_[max_chunks];
+                std::mutex mutex_;
+                std::size_t size_ = 0;
+        };
+
+        /*
+         * Treiber stack of node indices. The head carries a tag which is bumped on every change so a
+         * node that was popped and pushed again in between (ABA) makes a stale compare-exchange fail.
+         */
+        template <class Pointer>
+        class index_stack
+        {
+            public:
+                using store_type = node_store<Pointer>;
+
+                index_stack(store_type& nodes) noexcept : nodes_(nodes) {}
+
+                auto push(std::uint32_t idx) noexcept -> void
+                {
+                    auto old = head_.load(std::memory_order_relaxed);
+                    auto head = std::uint64_t{};
+                    do
+                    {
+                        nodes_[idx].next.store(static_cast<std::uint32_t>(old), std::memory_order_relaxed);
+                        head = (((old >> 32) + 1) << 32) | idx;
+                    } while(!head_.compare_exchange_weak(old, head, std::memory_order_release, std::memory_order_relaxed));
+                }
+
+                // returns 0 if the stack is empty
+                auto pop() noexcept -> std::uint32_t
+                {
+                    auto old = head_.load(std::memory_order_acquire);
+                    while(static_cast<std::uint32_t>(old) != 0)
+                    {
+                        auto idx = static_cast<std::uint32_t>(old);
+                        auto next = nodes_[idx].next.load(std::memory_order_relaxed);
+                        auto head = (((old >> 32) + 1) << 32) | next;
+                        if(head_.compare_exchange_weak(old, head, std::memory_order_acquire, std::memory_order_acquire))
+                            return idx;
+                    }
+                    return 0;
+                }
+
+            private:
+                store_type& nodes_;
+                std::atomic<std::uint64_t> head_{0};
+        };
+
+        struct free_list_traffic
+        {
+            std::uint64_t pops = 0;
+            std::uint64_t pushes = 0;
+        };
+
+        /*
+         * Free list of pool_allocator. Blocks are kept in nodes outside of the blocks themselves
+         * (device memory can't hold a link), nodes are recycled through a second stack, so a
+         * steady-state pool never allocates on the host. Every thread has a small magazine in
+         * front of the shared stacks and only moves half a magazine at a time to or from them. A
+         * thread which finds both empty takes the blocks other threads freed out of their
+         * magazines before it reports a miss. An exiting thread hands its blocks to the shared
+         * stack and its magazine to the next thread.
+         */
+        template <class Pointer>
+        class pool_free_list
+        {
+            public:
+                static constexpr auto magazine_size = std::size_t{16};
+
+            public:
+                pool_free_list() : state_{std::make_shared<state>()} {}
+
+                pool_free_list(pool_free_list&&) noexcept = default;
+                auto operator=(pool_free_list&&) noexcept -> pool_free_list& = default;
+
+                // returns false if there is no free block
+                auto pop(Pointer& p) -> bool
+                {
+                    auto&& m = local();
+                    {
+                        auto&& lock = magazine_lock{m};
+                        if(m.blocks.empty())
+                            while((m.blocks.size() < magazine_size / 2) && state_->pop_shared(m.blocks)) {}
+
+                        if(!m.blocks.empty())
+                        {
+                            p = m.blocks.back();
+                            m.blocks.pop_back();
+                            m.count();
+                            ++m.pops;
+                            return true;
+                        }
+                    }
+
+                    // blocks freed on other threads may still sit in their magazines
+                    return state_->steal(m, p);
+                }
+
+                // returns false if the host is out of memory for a magazine or a node, p isn't kept then
+                auto push(const Pointer& p) noexcept -> bool
+                {
+                    auto m = static_cast<magazine*>(nullptr);
+                    try
+                    {
+                        m = &local();
+                    }
+                    catch(...)
+                    {
+                        return state_->try_push_shared(p);
+                    }
+
+                    auto&& lock = magazine_lock{*m};
+                    if(m->blocks.size() == magazine_size)
+                    {
+                        while((m->blocks.size() > magazine_size / 2) && state_->try_push_shared(m->blocks.back()))
+                            m->blocks.pop_back();
+
+                        if(m->blocks.size() == magazine_size)
+                            return false;
+                    }
+
+                    m->blocks.push_back(p); // within the capacity reserved by the magazine
+                    m->count();
+                    ++m->pushes;
+                    return true;
+                }
+
+                // bypasses the magazine, so every thread can take the block right away
+                auto push_shared(const Pointer& p) -> void
+                {
+                    state_->push_shared(p);
+                }
+
+                // counts the pops and pushes of all threads
+                auto traffic() const -> free_list_traffic
+                {
+                    auto ret = free_list_traffic{};
+                    auto&& lock = std::lock_guard<std::mutex>{state_->mutex};
+                    for(auto&& m : state_->magazines)
+                    {
+                        auto&& mlock = magazine_lock{*m};
+                        ret.pops += m->pops;
+                        ret.pushes += m->pushes;
+                    }
+                    return ret;
+                }
+
+                // hands every free block to f and empties the list, must not run concurrently with push or pop
+                template <class Func>
+                auto drain(Func f) -> void
+                {
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{state_->mutex};
+                        for(auto&& m : state_->magazines)
+                        {
+                            auto&& mlock = magazine_lock{*m};
+                            for(auto&& p : m->blocks)
+                                f(p);
+                            m->blocks.clear();
+                            m->count();
+                        }
+                    }
+
+                    auto blocks = std::vector<Pointer>{};
+                    while(state_->pop_shared(blocks))
+                    {
+                        f(blocks.back());
+                        blocks.pop_back();
+                    }
+                }
+
+            private:
+                struct magazine
+                {
+                    magazine() { blocks.reserve(magazine_size); }
+
+                    // called under lock after blocks changed
+                    auto count() noexcept -> void
+                    {
+                        held.store(blocks.size(), std::memory_order_relaxed);
+                    }
+
+                    std::atomic_flag lock = ATOMIC_FLAG_INIT; // only contended by drain(), traffic() and steal()
+                    std::vector<Pointer> blocks;
+                    std::atomic<std::size_t> held{0}; // lets thieves skip empty magazines without the lock
+                    std::uint64_t pops = 0; // guarded by lock like blocks
+                    std::uint64_t pushes = 0;
+                    magazine* next = nullptr; // set before the magazine is published
+                    char pad[64];
+                };
+
+                class magazine_lock
+                {
+                    public:
+                        magazine_lock(magazine& m) noexcept : m_(m)
+                        {
+                            while(m_.lock.test_and_set(std::memory_order_acquire))
+                                std::this_thread::yield();
+                        }
+
+                        ~magazine_lock() { m_.lock.clear(std::memory_order_release); }
+
+                    private:
+                        magazine& m_;
+                };
+
+                struct state
+                {
+                    state() : blocks{nodes}, spare{nodes}, id{next_pool_id()} {}
+
+                    auto push_shared(const Pointer& p) -> void
+                    {
+                        auto idx = spare.pop();
+                        if(idx == 0)
+                            idx = nodes.make_node();
+
+                        nodes[idx].value = p;
+                        blocks.push(idx);
+                    }
+
+                    auto try_push_shared(const Pointer& p) noexcept -> bool
+                    {
+                        try
+                        {
+                            push_shared(p);
+                            return true;
+                        }
+                        catch(...)
+                        {
+                            return false;
+                        }
+                    }
+
+                    auto pop_shared(std::vector<Pointer>& out) -> bool
+                    {
+                        auto idx = blocks.pop();
+                        if(idx == 0)
+                            return false;
+
+                        out.push_back(nodes[idx].value);
+                        spare.push(idx);
+                        return true;
+                    }
+
+                    /*
+                     * Takes a free block and up to half a magazine more from the magazine of another
+                     * thread into m. Empty magazines are skipped without their locks, so a thread
+                     * which finds nothing takes no lock at all. Only thieves hold two locks, they
+                     * take them in address order.
+                     */
+                    auto steal(magazine& m, Pointer& p) -> bool
+                    {
+                        for(auto o = first.load(std::memory_order_acquire); o != nullptr; o = o->next)
+                        {
+                            if((o == &m) || (o->held.load(std::memory_order_relaxed) == 0))
+                                continue;
+
+                            auto ordered = std::less<magazine*>{}(o, &m);
+                            auto&& lock_a = magazine_lock{ordered ? *o : m};
+                            auto&& lock_b = magazine_lock{ordered ? m : *o};
+                            if(o->blocks.empty())
+                                continue;
+
+                            p = o->blocks.back();
+                            o->blocks.pop_back();
+                            while(!o->blocks.empty() && (m.blocks.size() < magazine_size / 2))
+                            {
+                                m.blocks.push_back(o->blocks.back());
+                                o->blocks.pop_back();
+                            }
+                            o->count();
+                            m.count();
+                            ++m.pops;
+                            return true;
+                        }
+                        return false;
+                    }
+
+                    /*
+                     * A drain() which already passed m finds the blocks on the shared stack. Blocks
+                     * the shared stack can't take stay in m, which drain() visits as well. Runs in
+                     * a thread_local destructor, so it must not throw: local() reserved room in
+                     * retired for every magazine.
+                     */
+                    auto retire(magazine& m) noexcept -> void
+                    {
+                        {
+                            auto&& mlock = magazine_lock{m};
+                            while(!m.blocks.empty() && try_push_shared(m.blocks.back()))
+                                m.blocks.pop_back();
+                            m.count();
+                        }
+
+                        auto&& lock = std::lock_guard<std::mutex>{mutex};
+                        retired.push_back(&m);
+                    }
+
+                    node_store<Pointer> nodes;
+                    index_stack<Pointer> blocks; // nodes holding a free block
+                    index_stack<Pointer> spare;  // empty nodes
+                    std::uint64_t id;
+                    std::mutex mutex;
+                    std::vector<std::unique_ptr<magazine>> magazines;
+                    std::atomic<magazine*> first{nullptr}; // all magazines, newest first, for steal()
+                    std::vector<magazine*> retired; // magazines of exited threads, kept for their counters
+                };
+
+                // the magazines a thread uses, retired when it exits
+                struct thread_magazines
+                {
+                    struct entry
+                    {
+                        std::uint64_t id;
+                        std::weak_ptr<state> owner;
+                        magazine* m;
+                    };
+
+                    thread_magazines() = default;
+                    thread_magazines(const thread_magazines&) = delete;
+                    auto operator=(const thread_magazines&) -> thread_magazines& = delete;
+
+                    ~thread_magazines()
+                    {
+                        for(auto&& e : entries)
+                        {
+                            auto s = e.owner.lock();
+                            if(s != nullptr)
+                                s->retire(*e.m);
+                        }
+                    }
+
+                    std::vector<entry> entries;
+                };
+
+                /*
+                 * Pool ids are never reused, so a cached id can't match a later pool. Entries of
+                 * destroyed pools are dropped whenever the thread meets a new pool.
+                 */
+                auto local() -> magazine&
+                {
+                    static thread_local auto last_id = std::uint64_t{0};
+                    static thread_local auto last = static_cast<magazine*>(nullptr);
+                    static thread_local thread_magazines mine;
+
+                    if(last_id == state_->id)
+                        return *last;
+
+                    auto& entries = mine.entries;
+                    auto it = std::find_if(std::begin(entries), std::end(entries),
+                                            [this](const typename thread_magazines::entry& e) { return e.id == state_->id; });
+                    if(it == std::end(entries))
+                    {
+                        entries.erase(std::remove_if(std::begin(entries), std::end(entries),
+                                                        [](const typename thread_magazines::entry& e) { return e.owner.expired(); }),
+                                        std::end(entries));
+
+                        if(entries.capacity() == entries.size())
+                            entries.reserve(2 * entries.size() + 1);
+                        auto m = static_cast<magazine*>(nullptr);
+                        {
+                            auto&& lock = std::lock_guard<std::mutex>{state_->mutex};
+                            if(state_->retired.empty())
+                            {
+                                auto fresh = std::unique_ptr<magazine>{new magazine{}};
+                                auto count = state_->magazines.size() + 1;
+                                if(state_->retired.capacity() < count)
+                                    state_->retired.reserve(2 * count);
+                                state_->magazines.push_back(std::move(fresh));
+                                m = state_->magazines.back().get();
+                                m->next = state_->first.load(std::memory_order_relaxed);
+                                state_->first.store(m, std::memory_order_release);
+                            }
+                            else
+                            {
+                                m = state_->retired.back();
+                                state_->retired.pop_back();
+                            }
+                        }
+
+                        entries.push_back(typename thread_magazines::entry{state_->id, state_, m});
+                        it = std::prev(std::end(entries));
+                    }
+
+                    last_id = state_->id;
+                    last = it->m;
+                    return *last;
+                }
+
+            private:
+                std::shared_ptr<state> state_;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_FREE_LIST_H_ */
@@ -0,0 +1,290 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_HOME_H_
+#define GLADOS_BITS_POOL_HOME_H_
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Shared between a pool_allocator and the deleters of its smart pointers. While the pool
+         * exists, blocks go back to it. Once an owning pool is gone, they go straight to
+         * InternalAlloc. Only the deleters of owning pools hold references: blocks of a manual pool
+         * have to come back before the pool is destroyed anyway.
+         */
+        template <class Pool, class InternalAlloc>
+        class pool_home
+        {
+            public:
+                pool_home(Pool* pool, bool owning) noexcept : pool_{pool}, owning_{owning} {}
+
+                auto move_to(Pool* pool) noexcept -> void
+                {
+                    pool_.store(pool);
+                }
+
+                auto owning() const noexcept -> bool
+                {
+                    return owning_;
+                }
+
+                template <class Pointer, class... Sizes>
+                auto give_back(Pointer p, Sizes... sizes) noexcept -> void
+                {
+                    if(!owning_)
+                    {
+                        pool_.load(std::memory_order_relaxed)->recycle(p, sizes...);
+                        return;
+                    }
+
+                    // seq_cst pairs with close(): either we see the closed pool or it sees us
+                    ++users_;
+                    auto pool = pool_.load();
+                    if(pool != nullptr)
+                        pool->recycle(p, sizes...);
+                    else
+                        alloc_.deallocate(p, sizes...);
+                    --users_;
+                }
+
+                // afterwards no deleter touches the pool any more
+                auto close() noexcept -> void
+                {
+                    pool_.store(nullptr);
+                    while(users_.load() != 0)
+                        std::this_thread::yield();
+                }
+
+                auto retain() noexcept -> void
+                {
+                    refs_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                // the pool and every deleter of an owning pool drop their reference once
+                auto drop() noexcept -> void
+                {
+                    if(refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        delete this;
+                }
+
+            private:
+                std::atomic<Pool*> pool_;
+                std::atomic<unsigned> users_{0};
+                std::atomic<unsigned> refs_{1};
+                bool owning_;
+                InternalAlloc alloc_;
+        };
+
+        /*
+         * Deleter of the smart pointers of pool_allocator. Holds the home of the pool and the shape
+         * of the block, pitched blocks additionally keep their pitched pointer. Copies of an
+         * owning pool's deleter hold their own reference to the home, cuda::unique_ptr copies its
+         * deleter.
+         */
+        template <class Home, class Pointer, std::size_t Dims>
+        class pool_deleter {};
+
+        template <class Home, class Pointer>
+        class pool_deleter<Home, Pointer, 1>
+        {
+            public:
+                pool_deleter() noexcept = default;
+
+                pool_deleter(Home* home, std::size_t n) noexcept : home_{home}, n_{n}
+                {
+                    if(home_->owning())
+                        home_->retain();
+                }
+
+                pool_deleter(const pool_deleter& other) noexcept : home_{other.home_}, n_{other.n_}
+                {
+                    if((home_ != nullptr) && home_->owning())
+                        home_->retain();
+                }
+
+                pool_deleter(pool_deleter&& other) noexcept : home_{other.home_}, n_{other.n_}
+                {
+                    other.home_ = nullptr;
+                }
+
+                auto operator=(const pool_deleter& other) noexcept -> pool_deleter&
+                {
+                    auto copy = other;
+                    return *this = std::move(copy);
+                }
+
+                auto operator=(pool_deleter&& other) noexcept -> pool_deleter&
+                {
+                    std::swap(home_, other.home_);
+                    std::swap(n_, other.n_);
+                    return *this;
+                }
+
+                ~pool_deleter()
+                {
+                    if((home_ != nullptr) && home_->owning())
+                        home_->drop();
+                }
+
+                template <class T>
+                auto operator()(T* p) const noexcept -> void
+                {
+                    home_->give_back(Pointer{p}, n_);
+                }
+
+            private:
+                Home* home_ = nullptr;
+                std::size_t n_ = 0;
+        };
+
+        template <class Home, class Pointer>
+        class pool_deleter<Home, Pointer, 2>
+        {
+            public:
+                pool_deleter() noexcept = default;
+
+                pool_deleter(Home* home, Pointer p, std::size_t x, std::size_t y) noexcept
+                : home_{home}, p_{p}, x_{x}, y_{y}
+                {
+                    if(home_->owning())
+                        home_->retain();
+                }
+
+                pool_deleter(const pool_deleter& other) noexcept
+                : home_{other.home_}, p_{other.p_}, x_{other.x_}, y_{other.y_}
+                {
+                    if((home_ != nullptr) && home_->owning())
+                        home_->retain();
+                }
+
+                pool_deleter(pool_deleter&& other) noexcept
+                : home_{other.home_}, p_{other.p_}, x_{other.x_}, y_{other.y_}
+                {
+                    other.home_ = nullptr;
+                }
+
+                auto operator=(const pool_deleter& other) noexcept -> pool_deleter&
+                {
+                    auto copy = other;
+                    return *this = std::move(copy);
+                }
+
+                auto operator=(pool_deleter&& other) noexcept -> pool_deleter&
+                {
+                    std::swap(home_, other.home_);
+                    std::swap(p_, other.p_);
+                    std::swap(x_, other.x_);
+                    std::swap(y_, other.y_);
+                    return *this;
+                }
+
+                ~pool_deleter()
+                {
+                    if((home_ != nullptr) && home_->owning())
+                        home_->drop();
+                }
+
+                template <class T>
+                auto operator()(T*) const noexcept -> void
+                {
+                    home_->give_back(p_, x_, y_);
+                }
+
+            private:
+                Home* home_ = nullptr;
+                Pointer p_{nullptr};
+                std::size_t x_ = 0;
+                std::size_t y_ = 0;
+        };
+
+        template <class Home, class Pointer>
+        class pool_deleter<Home, Pointer, 3>
+        {
+            public:
+                pool_deleter() noexcept = default;
+
+                pool_deleter(Home* home, Pointer p, std::size_t x, std::size_t y, std::size_t z) noexcept
+                : home_{home}, p_{p}, x_{x}, y_{y}, z_{z}
+                {
+                    if(home_->owning())
+                        home_->retain();
+                }
+
+                pool_deleter(const pool_deleter& other) noexcept
+                : home_{other.home_}, p_{other.p_}, x_{other.x_}, y_{other.y_}, z_{other.z_}
+                {
+                    if((home_ != nullptr) && home_->owning())
+                        home_->retain();
+                }
+
+                pool_deleter(pool_deleter&& other) noexcept
+                : home_{other.home_}, p_{other.p_}, x_{other.x_}, y_{other.y_}, z_{other.z_}
+                {
+                    other.home_ = nullptr;
+                }
+
+                auto operator=(const pool_deleter& other) noexcept -> pool_deleter&
+                {
+                    auto copy = other;
+                    return *this = std::move(copy);
+                }
+
+                auto operator=(pool_deleter&& other) noexcept -> pool_deleter&
+                {
+                    std::swap(home_, other.home_);
+                    std::swap(p_, other.p_);
+                    std::swap(x_, other.x_);
+                    std::swap(y_, other.y_);
+                    std::swap(z_, other.z_);
+                    return *this;
+                }
+
+                ~pool_deleter()
+                {
+                    if((home_ != nullptr) && home_->owning())
+                        home_->drop();
+                }
+
+                template <class T>
+                auto operator()(T*) const noexcept -> void
+                {
+                    home_->give_back(p_, x_, y_, z_);
+                }
+
+            private:
+                Home* home_ = nullptr;
+                Pointer p_{nullptr};
+                std::size_t x_ = 0;
+                std::size_t y_ = 0;
+                std::size_t z_ = 0;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_HOME_H_ */
@@ -0,0 +1,197 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_LIMIT_H_
+#define GLADOS_BITS_POOL_LIMIT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Counts the blocks a pool_allocator has handed out and blocks callers once the limit is
+         * reached until a block comes back. A limit of 0 means unlimited, nothing is counted then
+         * unless track() asked for it. While counting, the peak is kept as the high water mark.
+         */
+        class pool_limit
+        {
+            public:
+                pool_limit() noexcept = default;
+                pool_limit(std::size_t limit) noexcept : limit_{limit} {}
+
+                pool_limit(pool_limit&& other) noexcept
+                : limit_{other.limit_}, tracked_{other.tracked_}, current_{other.current_.load()}
+                , high_water_{other.high_water_.load()}, wait_ns_{other.wait_ns_.load()}
+                {}
+
+                auto operator=(pool_limit&& other) noexcept -> pool_limit&
+                {
+                    limit_ = other.limit_;
+                    tracked_ = other.tracked_;
+                    current_.store(other.current_.load());
+                    high_water_.store(other.high_water_.load());
+                    wait_ns_.store(other.wait_ns_.load());
+                    return *this;
+                }
+
+                auto try_acquire() noexcept -> bool
+                {
+                    if(limit_ == 0)
+                    {
+                        if(tracked_)
+                            raise(current_.fetch_add(1, std::memory_order_relaxed) + 1);
+                        return true;
+                    }
+
+                    auto cur = current_.load();
+                    while(cur < limit_)
+                    {
+                        if(current_.compare_exchange_weak(cur, cur + 1))
+                        {
+                            raise(cur + 1);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                auto acquire() -> void
+                {
+                    if(try_acquire())
+                        return;
+
+                    auto start = std::chrono::steady_clock::now();
+                    auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                    ++waiters_;
+                    cv_.wait(lock, [this]() { return try_acquire(); });
+                    --waiters_;
+                    add_wait(start);
+                }
+
+                template <class Rep, class Period>
+                auto acquire_for(const std::chrono::duration<Rep, Period>& timeout) -> bool
+                {
+                    if(try_acquire())
+                        return true;
+
+                    auto start = std::chrono::steady_clock::now();
+                    auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                    ++waiters_;
+                    auto ret = cv_.wait_for(lock, timeout, [this]() { return try_acquire(); });
+                    --waiters_;
+                    add_wait(start);
+                    return ret;
+                }
+
+                auto release() noexcept -> void
+                {
+                    if(limit_ == 0)
+                    {
+                        if(tracked_)
+                            current_.fetch_sub(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    // seq_cst on both sides: either the waiter sees the free slot or we see the waiter
+                    --current_;
+                    wake();
+                }
+
+                auto limit() const noexcept -> std::size_t
+                {
+                    return limit_;
+                }
+
+                // counts without a limit, too; must come before the first acquire
+                auto track() noexcept -> void
+                {
+                    tracked_ = true;
+                }
+
+                auto counting() const noexcept -> bool
+                {
+                    return (limit_ != 0) || tracked_;
+                }
+
+                auto in_use() const noexcept -> std::size_t
+                {
+                    return current_.load(std::memory_order_relaxed);
+                }
+
+                auto high_water() const noexcept -> std::size_t
+                {
+                    return high_water_.load(std::memory_order_relaxed);
+                }
+
+                // summed over all callers which had to wait
+                auto wait_time() const noexcept -> std::chrono::nanoseconds
+                {
+                    return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(wait_ns_.load(std::memory_order_relaxed))};
+                }
+
+            private:
+                auto raise(std::size_t n) noexcept -> void
+                {
+                    auto cur = high_water_.load(std::memory_order_relaxed);
+                    while((n > cur) && !high_water_.compare_exchange_weak(cur, n, std::memory_order_relaxed)) {}
+                }
+
+                auto add_wait(std::chrono::steady_clock::time_point start) noexcept -> void
+                {
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                    wait_ns_.fetch_add(static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+                }
+
+                auto wake() noexcept -> void
+                {
+                    if(waiters_.load() == 0)
+                        return;
+
+                    // a waiter between checking its predicate and going to sleep holds the mutex
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    }
+
+                    cv_.notify_one();
+                }
+
+            private:
+                std::size_t limit_ = 0;
+                bool tracked_ = false;
+                std::atomic<std::size_t> current_{0};
+                std::atomic<std::size_t> high_water_{0};
+                std::atomic<std::size_t> waiters_{0};
+                std::atomic<std::uint64_t> wait_ns_{0};
+                std::mutex mutex_;
+                std::condition_variable cv_;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_LIMIT_H_ */
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_STATS_H_
+#define GLADOS_BITS_POOL_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include <glados/bits/pool_limit.h>
+
+namespace glados
+{
+    /*
+     * Snapshot of a pool_allocator. Blocks in use come from the counter of the limit if it runs,
+     * otherwise they are derived from the counters of all threads and only exact while the pool
+     * is quiescent. high_water needs the limit's counter and stays 0 without it. Bytes are
+     * counted from the requested shapes; row padding of pitched allocations is not included.
+     */
+    struct pool_stats
+    {
+        std::uint64_t created = 0;     // by InternalAlloc, including reserve()
+        std::uint64_t released = 0;    // back to InternalAlloc
+        std::uint64_t in_use = 0;
+        std::uint64_t free = 0;
+        std::uint64_t high_water = 0;  // most blocks in use at once, what a limit would have to allow
+        std::uint64_t held_high_water = 0; // most blocks held at once, in use or free
+        std::uint64_t hits = 0;        // allocations served from the free lists
+        std::uint64_t misses = 0;      // allocations which needed a new block
+        std::chrono::nanoseconds wait_time{0}; // spent waiting for the limit
+        std::uint64_t bytes_held = 0;
+
+        auto hit_rate() const noexcept -> double
+        {
+            return (hits + misses == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+    };
+
+    inline auto operator<<(std::ostream& os, const pool_stats& s) -> std::ostream&
+    {
+        os << "blocks created " << s.created << ", released " << s.released
+           << ", in use " << s.in_use << ", free " << s.free << ", high water " << s.high_water
+           << " in use / " << s.held_high_water << " held"
+           << "; hit rate " << s.hit_rate() * 100.0 << " % (" << s.hits << " hits, " << s.misses << " misses)"
+           << "; waited " << std::chrono::duration<double, std::milli>(s.wait_time).count() << " ms"
+           << "; " << s.bytes_held << " bytes held";
+        return os;
+    }
+
+    namespace detail
+    {
+        // the counters of the slow paths, the fast paths are counted by the free lists
+        class pool_counters
+        {
+            public:
+                pool_counters() noexcept = default;
+
+                pool_counters(pool_counters&& other) noexcept
+                : misses_{other.misses_.load()}, reserved_{other.reserved_.load()}
+                , direct_returns_{other.direct_returns_.load()}, released_{other.released_.load()}
+                , bytes_{other.bytes_.load()}, held_high_water_{other.held_high_water_.load()}
+                {}
+
+                auto operator=(pool_counters&& other) noexcept -> pool_counters&
+                {
+                    misses_.store(other.misses_.load());
+                    reserved_.store(other.reserved_.load());
+                    direct_returns_.store(other.direct_returns_.load());
+                    released_.store(other.released_.load());
+                    bytes_.store(other.bytes_.load());
+                    held_high_water_.store(other.held_high_water_.load());
+                    return *this;
+                }
+
+                auto missed(std::size_t bytes) noexcept -> void
+                {
+                    misses_.fetch_add(1);
+                    add(bytes);
+                }
+
+                auto reserved(std::size_t bytes) noexcept -> void
+                {
+                    reserved_.fetch_add(1);
+                    add(bytes);
+                }
+
+                // a block which went back to InternalAlloc without passing through a free list
+                auto returned_directly(std::size_t bytes) noexcept -> void
+                {
+                    direct_returns_.fetch_add(1);
+                    released(bytes);
+                }
+
+                auto released(std::size_t bytes) noexcept -> void
+                {
+                    released_.fetch_add(1);
+                    bytes_.fetch_sub(bytes);
+                }
+
+                auto snapshot(std::uint64_t hits, std::uint64_t pushes, const pool_limit& limit) const noexcept -> pool_stats
+                {
+                    auto s = pool_stats{};
+                    s.misses = misses_.load();
+                    s.created = s.misses + reserved_.load();
+                    s.released = released_.load();
+                    s.hits = hits;
+
+                    if(limit.counting())
+                        s.in_use = limit.in_use();
+                    else
+                    {
+                        auto taken = hits + s.misses;
+                        auto returned = pushes + direct_returns_.load();
+                        s.in_use = (taken > returned) ? taken - returned : 0;
+                    }
+
+                    auto held = s.created - s.released;
+                    s.free = (held > s.in_use) ? held - s.in_use : 0;
+                    s.high_water = limit.high_water();
+                    s.held_high_water = held_high_water_.load();
+                    s.wait_time = limit.wait_time();
+                    s.bytes_held = bytes_.load();
+                    return s;
+                }
+
+            private:
+                auto add(std::size_t bytes) noexcept -> void
+                {
+                    bytes_.fetch_add(bytes);
+                    auto held = misses_.load() + reserved_.load() - released_.load();
+                    auto cur = held_high_water_.load();
+                    while((held > cur) && !held_high_water_.compare_exchange_weak(cur, held)) {}
+                }
+
+            private:
+                std::atomic<std::uint64_t> misses_{0};
+                std::atomic<std::uint64_t> reserved_{0};
+                std::atomic<std::uint64_t> direct_returns_{0};
+                std::atomic<std::uint64_t> released_{0};
+                std::atomic<std::uint64_t> bytes_{0};
+                std::atomic<std::uint64_t> held_high_water_{0};
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_STATS_H_ */
@@ -92,7 +92,7 @@ namespace glados
 
                 unique_ptr(pointer ptr,
                             typename std::remove_reference<deleter_type>::type&& d2) noexcept
-                : ptr_{ptr.ptr()}, pitch_{ptr.pitch()}, deleter_(d2)
+                : ptr_{ptr.ptr()}, pitch_{ptr.pitch()}, deleter_(std::move(d2))
                 {}
 
                 unique_ptr(unique_ptr&& u)
@@ -274,7 +274,7 @@ namespace glados
 
                 unique_ptr(pointer ptr,
                             typename std::remove_reference<deleter_type>::type&& d2) noexcept
-                : ptr_{ptr}, deleter_(d2)
+                : ptr_{ptr}, deleter_(std::move(d2))
                 {}
 
                 unique_ptr(unique_ptr&& u)
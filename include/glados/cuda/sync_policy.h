@@ -28,6 +28,7 @@
 #include <exception>
 #include <future>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 #ifndef __CUDACC__
@@ -63,11 +64,11 @@ namespace glados
                         constexpr auto s_size = sizeof(typename S::element_type);
 
                         auto d_pitch = d.pitch();
-                        if(D::mem_location == memory_location::host)
+                        if(!D::pitched_memory)
                             d_pitch = x * d_size;
 
                         auto s_pitch = s.pitch();
-                        if(S::mem_location == memory_location::host)
+                        if(!S::pitched_memory)
                             s_pitch = x * s_size;
 
                         auto d_pitched = make_cudaPitchedPtr(d.get(), d_pitch, x, y);
@@ -93,6 +94,22 @@ namespace glados
 
                         return parms;
             }
+
+            template <class P>
+            auto fill_host(P& p, int value, std::size_t x, std::size_t rows) -> typename std::enable_if<!P::pitched_memory, void>::type
+            {
+                std::fill_n(p.get(), x * rows, value);
+            }
+
+            // leaves the row padding of pitched host memory alone
+            template <class P>
+            auto fill_host(P& p, int value, std::size_t x, std::size_t rows) -> typename std::enable_if<P::pitched_memory, void>::type
+            {
+                using element_type = typename P::element_type;
+                auto bytes = reinterpret_cast<unsigned char*>(p.get());
+                for(auto r = std::size_t{0}; r < rows; ++r)
+                    std::fill_n(reinterpret_cast<element_type*>(bytes + r * p.pitch()), x, value);
+            }
         }
 
         class sync_policy
@@ -120,11 +137,11 @@ namespace glados
                     constexpr auto size = sizeof(typename D::element_type);
 
                     auto d_pitch = d.pitch();
-                    if(D::mem_location == memory_location::host)
+                    if(!D::pitched_memory)
                         d_pitch = x * size;
 
                     auto s_pitch = s.pitch();
-                    if(S::mem_location == memory_location::host)
+                    if(!S::pitched_memory)
                         s_pitch = x * size;
 
                     auto err = cudaMemcpy2D(d.get(), d_pitch, s.get(), s_pitch, x * size, y, detail::memcpy_direction<D::mem_location, S::mem_location>::value);
@@ -182,7 +199,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    std::fill_n(p.get(), x * y, value);
+                    detail::fill_host(p, value, x, y);
                 }
 
                 template <class P>
@@ -204,7 +221,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y, std::size_t z) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    std::fill_n(p.get(), x * y * z, value);
+                    detail::fill_host(p, value, x, y * z);
                 }
         };
 
@@ -237,11 +254,11 @@ namespace glados
                     constexpr auto size = sizeof(typename D::element_type);
 
                     auto d_pitch = d.pitch();
-                    if(D::mem_location == memory_location::host)
+                    if(!D::pitched_memory)
                         d_pitch = x * size;
 
                     auto s_pitch = s.pitch();
-                    if(S::mem_location == memory_location::host)
+                    if(!S::pitched_memory)
                         s_pitch = x * size;
 
                     auto err = cudaMemcpy2DAsync(d.get(), d_pitch, s.get(), s_pitch, x * size, y, detail::memcpy_direction<D::mem_location, S::mem_location>::value, stream);
@@ -308,7 +325,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    auto f = [&]() { std::fill_n(p.get(), x * y, value); };
+                    auto f = [&]() { detail::fill_host(p, value, x, y); };
                     auto&& t = std::thread{f};
                     t.detach();
                 }
@@ -332,7 +349,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y, std::size_t z) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    auto f = [&](){ std::fill_n(p.get(), x * y * z, value); };
+                    auto f = [&](){ detail::fill_host(p, value, x, y * z); };
                     auto&& t = std::thread{f};
                     t.detach();
                 }
@@ -0,0 +1,433 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_FFT_BITS_ENGINE_H_
+#define GLADOS_FFT_BITS_ENGINE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace glados
+{
+    namespace fft
+    {
+        namespace detail
+        {
+            // without the NaN and infinity handling of std::complex's operator*
+            template <class Real>
+            inline auto mul(const std::complex<Real>& a, const std::complex<Real>& b) noexcept -> std::complex<Real>
+            {
+                return std::complex<Real>{a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+            }
+
+            /*
+             * Unnormalized complex transform of one length. Lengths made of the factors 2, 3, 4 and 5
+             * use a recursive mixed-radix decimation in time, every other length goes through
+             * Bluestein's algorithm on a power of two. An engine is immutable after construction, so
+             * several threads may use it at once; each of them passes scratch_size() elements of
+             * scratch memory of its own to transform().
+             */
+            template <class Real>
+            class engine
+            {
+                public:
+                    using complex_type = std::complex<Real>;
+
+                    explicit engine(std::size_t n)
+                    : n_{n}
+                    {
+                        auto rest = factorize(n);
+                        if(rest == 1)
+                            twiddles_ = make_twiddles(n);
+                        else
+                            make_bluestein();
+                    }
+
+                    auto size() const noexcept -> std::size_t
+                    {
+                        return n_;
+                    }
+
+                    // only Bluestein needs scratch memory, two arrays of the padded length
+                    auto scratch_size() const noexcept -> std::size_t
+                    {
+                        return (bluestein_ != nullptr) ? 2 * bluestein_->sub->size() : 0;
+                    }
+
+                    /*
+                     * Transforms n elements at in, in_stride apart, into n contiguous elements at out.
+                     * in and out must not overlap. Inverse selects the positive exponent.
+                     */
+                    template <bool Inverse>
+                    auto transform(const complex_type* in, std::size_t in_stride, complex_type* out, complex_type* scratch) const -> void
+                    {
+                        if(n_ == 1)
+                            out[0] = in[0];
+                        else if(bluestein_ != nullptr)
+                            transform_bluestein<Inverse>(in, in_stride, out, scratch);
+                        else
+                            work<Inverse>(out, in, 1, in_stride, factors_.data());
+                    }
+
+                private:
+                    // stores (radix, remaining length) pairs, returns what is left for Bluestein
+                    auto factorize(std::size_t n) -> std::size_t
+                    {
+                        auto rest = n;
+                        for(auto p : {std::size_t{4}, std::size_t{2}, std::size_t{3}, std::size_t{5}})
+                        {
+                            while(rest % p == 0 && rest > 1)
+                            {
+                                rest /= p;
+                                factors_.push_back(p);
+                                factors_.push_back(rest);
+                            }
+                        }
+
+                        if(rest != 1)
+                            factors_.clear();
+                        return rest;
+                    }
+
+                    static auto make_twiddles(std::size_t n) -> std::vector<complex_type>
+                    {
+                        auto t = std::vector<complex_type>(n);
+                        const auto pi = std::acos(-1.0);
+                        for(auto i = std::size_t{0}; i < n; ++i)
+                        {
+                            auto phi = -2.0 * pi * static_cast<double>(i) / static_cast<double>(n);
+                            t[i] = complex_type{static_cast<Real>(std::cos(phi)), static_cast<Real>(std::sin(phi))};
+                        }
+                        return t;
+                    }
+
+                    template <bool Inverse>
+                    auto twiddle(std::size_t i) const noexcept -> complex_type
+                    {
+                        return Inverse ? std::conj(twiddles_[i]) : twiddles_[i];
+                    }
+
+                    template <bool Inverse>
+                    auto work(complex_type* out, const complex_type* in, std::size_t fstride, std::size_t in_stride,
+                                const std::size_t* factors) const -> void
+                    {
+                        auto p = factors[0];
+                        auto m = factors[1];
+
+                        if(m == 1)
+                        {
+                            for(auto i = std::size_t{0}; i < p; ++i)
+                                out[i] = in[i * fstride * in_stride];
+                        }
+                        else
+                        {
+                            for(auto i = std::size_t{0}; i < p; ++i)
+                                work<Inverse>(out + i * m, in + i * fstride * in_stride, fstride * p, in_stride, factors + 2);
+                        }
+
+                        switch(p)
+                        {
+                            case 2: butterfly2<Inverse>(out, fstride, m); break;
+                            case 3: butterfly3<Inverse>(out, fstride, m); break;
+                            case 4: butterfly4<Inverse>(out, fstride, m); break;
+                            case 5: butterfly5<Inverse>(out, fstride, m); break;
+                        }
+                    }
+
+                    template <bool Inverse>
+                    auto butterfly2(complex_type* out, std::size_t fstride, std::size_t m) const -> void
+                    {
+                        for(auto k = std::size_t{0}; k < m; ++k)
+                        {
+                            auto t = mul(out[k + m], twiddle<Inverse>(k * fstride));
+                            out[k + m] = out[k] - t;
+                            out[k] += t;
+                        }
+                    }
+
+                    template <bool Inverse>
+                    auto butterfly4(complex_type* out, std::size_t fstride, std::size_t m) const -> void
+                    {
+                        for(auto k = std::size_t{0}; k < m; ++k)
+                        {
+                            auto s0 = mul(out[k + m], twiddle<Inverse>(k * fstride));
+                            auto s1 = mul(out[k + 2 * m], twiddle<Inverse>(2 * k * fstride));
+                            auto s2 = mul(out[k + 3 * m], twiddle<Inverse>(3 * k * fstride));
+
+                            auto s5 = out[k] - s1;
+                            out[k] += s1;
+                            auto s3 = s0 + s2;
+                            auto s4 = s0 - s2;
+                            out[k + 2 * m] = out[k] - s3;
+                            out[k] += s3;
+
+                            // s4 turned by -i (forward) or +i (inverse)
+                            auto r = Inverse ? complex_type{-s4.imag(), s4.real()} : complex_type{s4.imag(), -s4.real()};
+                            out[k + m] = s5 + r;
+                            out[k + 3 * m] = s5 - r;
+                        }
+                    }
+
+                    template <bool Inverse>
+                    auto butterfly3(complex_type* out, std::size_t fstride, std::size_t m) const -> void
+                    {
+                        // imaginary part of exp(-+2 pi i / 3)
+                        const auto e = twiddle<Inverse>(fstride * m).imag();
+                        const auto half = Real{0.5};
+                        for(auto k = std::size_t{0}; k < m; ++k)
+                        {
+                            auto s1 = mul(out[k + m], twiddle<Inverse>(k * fstride));
+                            auto s2 = mul(out[k + 2 * m], twiddle<Inverse>(2 * k * fstride));
+                            auto sum = s1 + s2;
+                            auto diff = (s1 - s2) * e;
+
+                            auto mid = out[k] - sum * half;
+                            out[k] += sum;
+                            out[k + m] = complex_type{mid.real() - diff.imag(), mid.imag() + diff.real()};
+                            out[k + 2 * m] = complex_type{mid.real() + diff.imag(), mid.imag() - diff.real()};
+                        }
+                    }
+
+                    template <bool Inverse>
+                    auto butterfly5(complex_type* out, std::size_t fstride, std::size_t m) const -> void
+                    {
+                        const auto ya = twiddle<Inverse>(fstride * m);
+                        const auto yb = twiddle<Inverse>(2 * fstride * m);
+                        for(auto k = std::size_t{0}; k < m; ++k)
+                        {
+                            auto s0 = out[k];
+                            auto s1 = mul(out[k + m], twiddle<Inverse>(k * fstride));
+                            auto s2 = mul(out[k + 2 * m], twiddle<Inverse>(2 * k * fstride));
+                            auto s3 = mul(out[k + 3 * m], twiddle<Inverse>(3 * k * fstride));
+                            auto s4 = mul(out[k + 4 * m], twiddle<Inverse>(4 * k * fstride));
+
+                            auto s7 = s1 + s4;
+                            auto s10 = s1 - s4;
+                            auto s8 = s2 + s3;
+                            auto s9 = s2 - s3;
+
+                            out[k] = s0 + s7 + s8;
+
+                            auto s5 = s0 + s7 * ya.real() + s8 * yb.real();
+                            auto s6 = complex_type{s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                                                    -s10.real() * ya.imag() - s9.real() * yb.imag()};
+                            out[k + m] = s5 - s6;
+                            out[k + 4 * m] = s5 + s6;
+
+                            auto s11 = s0 + s7 * yb.real() + s8 * ya.real();
+                            auto s12 = complex_type{-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                                                     s10.real() * yb.imag() - s9.real() * ya.imag()};
+                            out[k + 2 * m] = s11 + s12;
+                            out[k + 3 * m] = s11 - s12;
+                        }
+                    }
+
+                    struct bluestein
+                    {
+                        std::vector<complex_type> chirp;    // exp(-i pi k^2 / n)
+                        std::vector<complex_type> kernel;   // transformed conj(chirp), wrapped around
+                        std::unique_ptr<engine> sub;
+                    };
+
+                    auto make_bluestein() -> void
+                    {
+                        auto m = std::size_t{1};
+                        while(m < 2 * n_ - 1)
+                            m <<= 1;
+
+                        bluestein_ = std::unique_ptr<bluestein>{new bluestein{}};
+                        auto& b = *bluestein_;
+                        b.sub = std::unique_ptr<engine>{new engine{m}};
+
+                        // k^2 modulo 2n keeps the angle accurate for large k
+                        const auto pi = std::acos(-1.0);
+                        b.chirp.resize(n_);
+                        for(auto k = std::size_t{0}; k < n_; ++k)
+                        {
+                            auto k2 = (static_cast<unsigned long long>(k) * k) % (2 * n_);
+                            auto phi = -pi * static_cast<double>(k2) / static_cast<double>(n_);
+                            b.chirp[k] = complex_type{static_cast<Real>(std::cos(phi)), static_cast<Real>(std::sin(phi))};
+                        }
+
+                        auto wrapped = std::vector<complex_type>(m);
+                        wrapped[0] = std::conj(b.chirp[0]);
+                        for(auto k = std::size_t{1}; k < n_; ++k)
+                            wrapped[k] = wrapped[m - k] = std::conj(b.chirp[k]);
+
+                        b.kernel.resize(m);
+                        b.sub->template transform<false>(wrapped.data(), 1, b.kernel.data(), nullptr);
+                    }
+
+                    // the inverse is conj(forward(conj(x)))
+                    template <bool Inverse>
+                    auto transform_bluestein(const complex_type* in, std::size_t in_stride, complex_type* out, complex_type* scratch) const -> void
+                    {
+                        auto& b = *bluestein_;
+                        auto m = b.sub->size();
+
+                        // the sub engine is a power of two and needs no scratch of its own
+                        auto a = scratch;
+                        auto fa = scratch + m;
+                        for(auto k = std::size_t{0}; k < n_; ++k)
+                        {
+                            auto x = in[k * in_stride];
+                            a[k] = mul(Inverse ? std::conj(x) : x, b.chirp[k]);
+                        }
+                        std::fill(a + n_, a + m, complex_type{});
+
+                        b.sub->template transform<false>(a, 1, fa, nullptr);
+                        for(auto k = std::size_t{0}; k < m; ++k)
+                            fa[k] = mul(fa[k], b.kernel[k]);
+                        b.sub->template transform<true>(fa, 1, a, nullptr);
+
+                        const auto scale = Real{1} / static_cast<Real>(m);
+                        for(auto k = std::size_t{0}; k < n_; ++k)
+                        {
+                            auto x = mul(a[k], b.chirp[k]) * scale;
+                            out[k] = Inverse ? std::conj(x) : x;
+                        }
+                    }
+
+                private:
+                    std::size_t n_;
+                    std::vector<std::size_t> factors_;
+                    std::vector<complex_type> twiddles_;
+                    std::unique_ptr<bluestein> bluestein_;
+            };
+
+            /*
+             * Real-to-complex and complex-to-real transforms of one length. Even lengths pack the
+             * real values into a complex transform of half the length, odd lengths use a full one.
+             * Like engine, every caller passes scratch_size() elements of scratch memory.
+             */
+            template <class Real>
+            class real_engine
+            {
+                public:
+                    using complex_type = std::complex<Real>;
+
+                    explicit real_engine(std::size_t n)
+                    : n_{n}, half_{(n % 2 == 0) ? n / 2 : n}
+                    {
+                        if(n % 2 == 0)
+                        {
+                            const auto pi = std::acos(-1.0);
+                            turns_.resize(n / 2);
+                            for(auto k = std::size_t{0}; k < n / 2; ++k)
+                            {
+                                auto phi = -2.0 * pi * static_cast<double>(k) / static_cast<double>(n);
+                                turns_[k] = complex_type{static_cast<Real>(std::cos(phi)), static_cast<Real>(std::sin(phi))};
+                            }
+                        }
+                    }
+
+                    auto scratch_size() const noexcept -> std::size_t
+                    {
+                        return 2 * half_.size() + half_.scratch_size();
+                    }
+
+                    // n real values in_stride apart to n / 2 + 1 contiguous complex values
+                    auto forward(const Real* in, std::size_t in_stride, complex_type* out, complex_type* scratch) const -> void
+                    {
+                        auto h = half_.size();
+                        auto z = scratch;
+                        auto zf = scratch + h;
+                        auto rest = scratch + 2 * h;
+                        if(n_ % 2 != 0)
+                        {
+                            for(auto j = std::size_t{0}; j < h; ++j)
+                                z[j] = complex_type{in[j * in_stride], Real{0}};
+
+                            half_.template transform<false>(z, 1, zf, rest);
+                            for(auto k = std::size_t{0}; k <= n_ / 2; ++k)
+                                out[k] = zf[k];
+                            return;
+                        }
+
+                        for(auto j = std::size_t{0}; j < h; ++j)
+                            z[j] = complex_type{in[2 * j * in_stride], in[(2 * j + 1) * in_stride]};
+
+                        half_.template transform<false>(z, 1, zf, rest);
+
+                        const auto half = Real{0.5};
+                        for(auto k = std::size_t{0}; k <= h; ++k)
+                        {
+                            auto zk = zf[k % h];
+                            auto zc = std::conj(zf[(h - k) % h]);
+                            auto even = (zk + zc) * half;
+                            auto odd = complex_type{(zk - zc).imag() * half, -(zk - zc).real() * half};
+                            out[k] = even + mul((k < h) ? turns_[k] : complex_type{Real{-1}, Real{0}}, odd);
+                        }
+                    }
+
+                    // n / 2 + 1 contiguous complex values to n real values out_stride apart, unnormalized
+                    auto inverse(const complex_type* in, Real* out, std::size_t out_stride, complex_type* scratch) const -> void
+                    {
+                        auto h = half_.size();
+                        auto z = scratch;
+                        auto zi = scratch + h;
+                        auto rest = scratch + 2 * h;
+                        if(n_ % 2 != 0)
+                        {
+                            // rebuild the Hermitian half which the input leaves out
+                            for(auto k = std::size_t{0}; k <= n_ / 2; ++k)
+                                z[k] = in[k];
+                            for(auto k = n_ / 2 + 1; k < n_; ++k)
+                                z[k] = std::conj(in[n_ - k]);
+
+                            half_.template transform<true>(z, 1, zi, rest);
+                            for(auto j = std::size_t{0}; j < n_; ++j)
+                                out[j * out_stride] = zi[j].real();
+                            return;
+                        }
+
+                        for(auto k = std::size_t{0}; k < h; ++k)
+                        {
+                            auto xk = in[k];
+                            auto xc = std::conj(in[h - k]);
+                            auto even = xk + xc;
+                            auto odd = mul(xk - xc, std::conj(turns_[k]));
+                            z[k] = even + complex_type{-odd.imag(), odd.real()};
+                        }
+
+                        half_.template transform<true>(z, 1, zi, rest);
+                        for(auto j = std::size_t{0}; j < h; ++j)
+                        {
+                            out[2 * j * out_stride] = zi[j].real();
+                            out[(2 * j + 1) * out_stride] = zi[j].imag();
+                        }
+                    }
+
+                private:
+                    std::size_t n_;
+                    engine<Real> half_;
+                    std::vector<complex_type> turns_; // exp(-2 pi i k / n) for k < n / 2
+            };
+        }
+    }
+}
+
+#endif /* GLADOS_FFT_BITS_ENGINE_H_ */
@@ -0,0 +1,380 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_FFT_PLAN_H_
+#define GLADOS_FFT_PLAN_H_
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glados/fft/bits/engine.h>
+
+namespace glados
+{
+    namespace fft
+    {
+        enum class type { r2c, c2r, c2c, d2z, z2d, z2z };
+
+        // same values as CUFFT_FORWARD and CUFFT_INVERSE
+        constexpr auto forward = -1;
+        constexpr auto inverse = 1;
+
+        namespace detail
+        {
+            template <class I, class O> struct type_chooser {};
+            template <> struct type_chooser<float, std::complex<float>> { static constexpr auto value = type::r2c; };
+            template <> struct type_chooser<std::complex<float>, float> { static constexpr auto value = type::c2r; };
+            template <> struct type_chooser<std::complex<float>, std::complex<float>> { static constexpr auto value = type::c2c; };
+            template <> struct type_chooser<double, std::complex<double>> { static constexpr auto value = type::d2z; };
+            template <> struct type_chooser<std::complex<double>, double> { static constexpr auto value = type::z2d; };
+            template <> struct type_chooser<std::complex<double>, std::complex<double>> { static constexpr auto value = type::z2z; };
+
+            template <class I> struct type_mapper {};
+            template <> struct type_mapper<float> { using type = std::complex<float>; };
+            template <> struct type_mapper<std::complex<float>> { using type = float; };
+            template <> struct type_mapper<double> { using type = std::complex<double>; };
+            template <> struct type_mapper<std::complex<double>> { using type = double; };
+
+            template <type T> struct real_of { using type = double; };
+            template <> struct real_of<type::r2c> { using type = float; };
+            template <> struct real_of<type::c2r> { using type = float; };
+            template <> struct real_of<type::c2c> { using type = float; };
+
+            /*
+             * The transforms of a plan, laid out like cufftPlanMany describes them: element i of
+             * batch b is found at b * dist + offset(i, embed) * stride. Without an embed array the
+             * data is dense and stride and distance are ignored. The engines are immutable, every
+             * execution works on its own buffers, which it allocates once for all of its batches.
+             */
+            template <class Real>
+            class plan_impl
+            {
+                public:
+                    using complex_type = std::complex<Real>;
+
+                    plan_impl(int rank, const int* n, const int* inembed, int istride, int idist,
+                                const int* onembed, int ostride, int odist, int batch, type t)
+                    : rank_{static_cast<std::size_t>(rank)}, batch_{static_cast<std::size_t>(batch)}
+                    {
+                        if(rank < 1 || rank > 3)
+                            throw std::invalid_argument{"glados::fft::plan: only ranks 1 to 3 are supported"};
+                        if(batch < 1)
+                            throw std::invalid_argument{"glados::fft::plan: the batch must not be empty"};
+
+                        auto real_in = (t == type::r2c) || (t == type::d2z);
+                        auto real_out = (t == type::c2r) || (t == type::z2d);
+
+                        for(auto d = std::size_t{0}; d < rank_; ++d)
+                        {
+                            if(n[d] < 1)
+                                throw std::invalid_argument{"glados::fft::plan: transform sizes must be positive"};
+                            n_[d] = static_cast<std::size_t>(n[d]);
+                            cn_[d] = n_[d];
+                        }
+
+                        if(real_in || real_out)
+                            cn_[rank_ - 1] = n_[rank_ - 1] / 2 + 1;
+
+                        in_ = make_layout(real_in ? n_ : cn_, inembed, istride, idist);
+                        out_ = make_layout(real_out ? n_ : cn_, onembed, ostride, odist);
+
+                        // the last dimension of a real transform goes through the real engine
+                        auto complex_dims = (real_in || real_out) ? rank_ - 1 : rank_;
+                        for(auto d = std::size_t{0}; d < complex_dims; ++d)
+                            engines_.emplace_back(new engine<Real>{n_[d]});
+                        if(real_in || real_out)
+                            real_ = std::unique_ptr<real_engine<Real>>{new real_engine<Real>{n_[rank_ - 1]}};
+
+                        // along() takes a line and the scratch of its engine, a real row only the scratch
+                        for(auto d = std::size_t{0}; d < complex_dims; ++d)
+                            scratch_ = std::max(scratch_, cn_[d] + engines_[d]->scratch_size());
+                        if(real_ != nullptr)
+                            scratch_ = std::max(scratch_, real_->scratch_size());
+                    }
+
+                    template <bool Inverse>
+                    auto c2c(const complex_type* in, complex_type* out) const -> void
+                    {
+                        auto buffer = std::vector<complex_type>(volume(cn_) + scratch_);
+                        auto tmp = buffer.data();
+                        auto scratch = tmp + volume(cn_);
+                        for(auto b = std::size_t{0}; b < batch_; ++b)
+                        {
+                            gather(in + b * in_.dist, in_, cn_, tmp);
+                            for(auto d = std::size_t{0}; d < rank_; ++d)
+                                along<Inverse>(tmp, d, scratch);
+                            scatter(tmp, cn_, out + b * out_.dist, out_);
+                        }
+                    }
+
+                    auto r2c(const Real* in, complex_type* out) const -> void
+                    {
+                        auto buffer = std::vector<complex_type>(volume(cn_) + scratch_);
+                        auto tmp = buffer.data();
+                        auto scratch = tmp + volume(cn_);
+                        auto clast = cn_[rank_ - 1];
+                        for(auto b = std::size_t{0}; b < batch_; ++b)
+                        {
+                            for(auto r = std::size_t{0}; r < rows(); ++r)
+                                real_->forward(in + b * in_.dist + row_offset(r, in_) * in_.stride, in_.stride, tmp + r * clast, scratch);
+
+                            for(auto d = std::size_t{0}; d + 1 < rank_; ++d)
+                                along<false>(tmp, d, scratch);
+                            scatter(tmp, cn_, out + b * out_.dist, out_);
+                        }
+                    }
+
+                    auto c2r(const complex_type* in, Real* out) const -> void
+                    {
+                        auto buffer = std::vector<complex_type>(volume(cn_) + scratch_);
+                        auto tmp = buffer.data();
+                        auto scratch = tmp + volume(cn_);
+                        auto clast = cn_[rank_ - 1];
+                        for(auto b = std::size_t{0}; b < batch_; ++b)
+                        {
+                            gather(in + b * in_.dist, in_, cn_, tmp);
+                            for(auto d = std::size_t{0}; d + 1 < rank_; ++d)
+                                along<true>(tmp, d, scratch);
+
+                            for(auto r = std::size_t{0}; r < rows(); ++r)
+                                real_->inverse(tmp + r * clast, out + b * out_.dist + row_offset(r, out_) * out_.stride, out_.stride, scratch);
+                        }
+                    }
+
+                private:
+                    struct layout
+                    {
+                        std::size_t embed[3];
+                        std::size_t stride;
+                        std::size_t dist;
+                    };
+
+                    auto make_layout(const std::size_t* dims, const int* embed, int stride, int dist) const -> layout
+                    {
+                        auto l = layout{{1, 1, 1}, 1, volume(dims)};
+                        for(auto d = std::size_t{0}; d < rank_; ++d)
+                            l.embed[d] = dims[d];
+
+                        if(embed == nullptr)
+                            return l;
+
+                        if(stride < 1 || dist < 0)
+                            throw std::invalid_argument{"glados::fft::plan: invalid stride or distance"};
+
+                        for(auto d = std::size_t{1}; d < rank_; ++d)
+                        {
+                            if(embed[d] < static_cast<int>(dims[d]))
+                                throw std::invalid_argument{"glados::fft::plan: embedding smaller than the transform"};
+                            l.embed[d] = static_cast<std::size_t>(embed[d]);
+                        }
+
+                        l.stride = static_cast<std::size_t>(stride);
+                        l.dist = static_cast<std::size_t>(dist);
+                        return l;
+                    }
+
+                    auto volume(const std::size_t* dims) const noexcept -> std::size_t
+                    {
+                        auto v = std::size_t{1};
+                        for(auto d = std::size_t{0}; d < rank_; ++d)
+                            v *= dims[d];
+                        return v;
+                    }
+
+                    // rows are the lines along the last dimension, numbered like a dense array
+                    auto rows() const noexcept -> std::size_t
+                    {
+                        auto r = std::size_t{1};
+                        for(auto d = std::size_t{0}; d + 1 < rank_; ++d)
+                            r *= n_[d];
+                        return r;
+                    }
+
+                    // element offset of the first element of row r, before the stride
+                    auto row_offset(std::size_t r, const layout& l) const noexcept -> std::size_t
+                    {
+                        switch(rank_)
+                        {
+                            case 1: return 0;
+                            case 2: return r * l.embed[1];
+                            default: return ((r / n_[1]) * l.embed[1] + r % n_[1]) * l.embed[2];
+                        }
+                    }
+
+                    template <class T>
+                    auto gather(const T* in, const layout& l, const std::size_t* dims, T* dense) const -> void
+                    {
+                        auto last = dims[rank_ - 1];
+                        for(auto r = std::size_t{0}; r < rows(); ++r)
+                        {
+                            auto row = in + row_offset(r, l) * l.stride;
+                            for(auto j = std::size_t{0}; j < last; ++j)
+                                dense[r * last + j] = row[j * l.stride];
+                        }
+                    }
+
+                    template <class T>
+                    auto scatter(const T* dense, const std::size_t* dims, T* out, const layout& l) const -> void
+                    {
+                        auto last = dims[rank_ - 1];
+                        for(auto r = std::size_t{0}; r < rows(); ++r)
+                        {
+                            auto row = out + row_offset(r, l) * l.stride;
+                            for(auto j = std::size_t{0}; j < last; ++j)
+                                row[j * l.stride] = dense[r * last + j];
+                        }
+                    }
+
+                    // transforms all lines of the dense complex array along dimension d
+                    template <bool Inverse>
+                    auto along(complex_type* data, std::size_t d, complex_type* scratch) const -> void
+                    {
+                        auto stride = std::size_t{1};
+                        for(auto e = d + 1; e < rank_; ++e)
+                            stride *= cn_[e];
+
+                        auto len = cn_[d];
+                        auto outer = volume(cn_) / (len * stride);
+                        auto line = scratch;
+                        for(auto o = std::size_t{0}; o < outer; ++o)
+                        {
+                            for(auto i = std::size_t{0}; i < stride; ++i)
+                            {
+                                auto first = data + o * len * stride + i;
+                                engines_[d]->template transform<Inverse>(first, stride, line, scratch + len);
+                                for(auto k = std::size_t{0}; k < len; ++k)
+                                    first[k * stride] = line[k];
+                            }
+                        }
+                    }
+
+                private:
+                    std::size_t rank_;
+                    std::size_t batch_;
+                    std::size_t n_[3] = {1, 1, 1};
+                    std::size_t cn_[3] = {1, 1, 1}; // n with the last dimension halved for real transforms
+                    layout in_;
+                    layout out_;
+                    std::vector<std::unique_ptr<engine<Real>>> engines_;
+                    std::unique_ptr<real_engine<Real>> real_;
+                    std::size_t scratch_ = 0; // elements of scratch memory an execution needs besides its array
+            };
+        }
+
+        /*
+         * CPU counterpart of cufft::plan with the same constructors and the same compile-time checks
+         * in execute(). As with cuFFT the last dimension is the contiguous one, i.e. plan(nx, ny)
+         * transforms nx rows of ny elements, and transforms are unnormalized.
+         *
+         * Copies of a plan share its immutable tables and a plan may execute on several threads at
+         * once. A default-constructed plan throws on execution.
+         */
+        template <type T>
+        class plan
+        {
+            private:
+                using real_type = typename detail::real_of<T>::type;
+                using complex_type = std::complex<real_type>;
+                using impl_type = detail::plan_impl<real_type>;
+
+            public:
+                static constexpr auto transformation_type = T;
+
+                plan() noexcept = default;
+                plan(int nx) : impl_{make(1, std::vector<int>{nx}.data(), nullptr, 1, 0, nullptr, 1, 0, 1)} {}
+                plan(int nx, int ny) : impl_{make(2, std::vector<int>{nx, ny}.data(), nullptr, 1, 0, nullptr, 1, 0, 1)} {}
+                plan(int nx, int ny, int nz) : impl_{make(3, std::vector<int>{nx, ny, nz}.data(), nullptr, 1, 0, nullptr, 1, 0, 1)} {}
+
+                plan(int rank, int* n, int* inembed, int istride, int idist,
+                                       int* onembed, int ostride, int odist,
+                                       int batch)
+                : impl_{make(rank, n, inembed, istride, idist, onembed, ostride, odist, batch)}
+                {}
+
+                template <class I, class O>
+                auto execute(I* idata, O* odata) -> void
+                {
+                    static_assert(!std::is_same<I, O>::value, "Plan needs a direction for transformations between the same types.");
+                    static_assert(detail::type_chooser<I, O>::value == transformation_type, "This plan can not be used for other types than originally specified.");
+                    static_assert(std::is_same<O, typename detail::type_mapper<I>::type>::value, "Attempt to transform to an incompatible type.");
+
+                    exec(idata, odata);
+                }
+
+                template <class I, class O>
+                auto execute(I* idata, O* odata, int direction) -> void
+                {
+                    static_assert(std::is_same<I, O>::value, "Transformations between different types are implicitly inverse");
+                    static_assert(detail::type_chooser<I, O>::value == transformation_type, "This plan can not be used for other types than originally specified.");
+
+                    if(direction != forward && direction != inverse)
+                        throw std::invalid_argument{"glados::fft::plan: the direction must be fft::forward or fft::inverse"};
+
+                    exec(idata, odata, direction);
+                }
+
+            private:
+                static auto make(int rank, const int* n, const int* inembed, int istride, int idist,
+                                    const int* onembed, int ostride, int odist, int batch)
+                -> std::shared_ptr<const impl_type>
+                {
+                    return std::make_shared<const impl_type>(rank, n, inembed, istride, idist, onembed, ostride, odist, batch, T);
+                }
+
+                auto get() const -> const impl_type&
+                {
+                    if(impl_ == nullptr)
+                        throw std::invalid_argument{"glados::fft::plan: the plan is empty"};
+                    return *impl_;
+                }
+
+                auto exec(complex_type* idata, complex_type* odata, int direction) -> void
+                {
+                    if(direction == forward)
+                        get().template c2c<false>(idata, odata);
+                    else
+                        get().template c2c<true>(idata, odata);
+                }
+
+                auto exec(real_type* idata, complex_type* odata) -> void
+                {
+                    get().r2c(idata, odata);
+                }
+
+                auto exec(complex_type* idata, real_type* odata) -> void
+                {
+                    get().c2r(idata, odata);
+                }
+
+            private:
+                std::shared_ptr<const impl_type> impl_;
+        };
+    }
+}
+
+#endif /* GLADOS_FFT_PLAN_H_ */
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_FFT_PLAN_CACHE_H_
+#define GLADOS_FFT_PLAN_CACHE_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace glados
+{
+    namespace fft
+    {
+        /*
+         * Process-wide cache of FFT plans, one per plan type. Plan may be fft::plan or cufft::plan,
+         * or anything else with their plan-many constructor. Plans are keyed on rank, sizes,
+         * embedding, strides, distances and batch; the transform type is part of Plan. Without an
+         * embed array strides and distances are ignored, as by the plans themselves.
+         *
+         * The cache hands out shared plans. fft::plan may execute on several threads at once, a
+         * shared cufft::plan needs its users to agree on one stream.
+         */
+        template <class Plan>
+        class plan_cache
+        {
+            public:
+                using plan_type = Plan;
+
+                static auto instance() -> plan_cache&
+                {
+                    static plan_cache cache;
+                    return cache;
+                }
+
+                auto get(int nx) -> std::shared_ptr<Plan>
+                {
+                    int n[] = {nx};
+                    return get(1, n, nullptr, 1, 0, nullptr, 1, 0, 1);
+                }
+
+                auto get(int nx, int ny) -> std::shared_ptr<Plan>
+                {
+                    int n[] = {nx, ny};
+                    return get(2, n, nullptr, 1, 0, nullptr, 1, 0, 1);
+                }
+
+                auto get(int nx, int ny, int nz) -> std::shared_ptr<Plan>
+                {
+                    int n[] = {nx, ny, nz};
+                    return get(3, n, nullptr, 1, 0, nullptr, 1, 0, 1);
+                }
+
+                auto get(int rank, int* n, int* inembed, int istride, int idist,
+                                       int* onembed, int ostride, int odist,
+                                       int batch) -> std::shared_ptr<Plan>
+                {
+                    auto key = make_key(rank, n, inembed, istride, idist, onembed, ostride, odist, batch);
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        auto it = plans_.find(key);
+                        if(it != std::end(plans_))
+                            return it->second;
+                    }
+
+                    // planning may take a while, other sizes don't have to wait for it
+                    auto p = std::make_shared<Plan>(rank, n, inembed, istride, idist, onembed, ostride, odist, batch);
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    return plans_.emplace(std::move(key), std::move(p)).first->second;
+                }
+
+                auto size() const -> std::size_t
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    return plans_.size();
+                }
+
+                // plans still in use stay alive with their users
+                auto clear() -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    plans_.clear();
+                }
+
+            private:
+                plan_cache() = default;
+
+                static auto make_key(int rank, const int* n, const int* inembed, int istride, int idist,
+                                        const int* onembed, int ostride, int odist, int batch) -> std::vector<int>
+                {
+                    auto key = std::vector<int>{rank, batch};
+                    for(auto d = 0; d < rank; ++d)
+                        key.push_back(n[d]);
+
+                    auto add = [&key, rank](const int* embed, int stride, int dist) {
+                        key.push_back(embed == nullptr ? 0 : 1);
+                        if(embed == nullptr)
+                            return;
+
+                        // the outermost extent doesn't matter, as for the plans
+                        for(auto d = 1; d < rank; ++d)
+                            key.push_back(embed[d]);
+                        key.push_back(stride);
+                        key.push_back(dist);
+                    };
+                    add(inembed, istride, idist);
+                    add(onembed, ostride, odist);
+                    return key;
+                }
+
+            private:
+                std::map<std::vector<int>, std::shared_ptr<Plan>> plans_;
+                mutable std::mutex mutex_;
+        };
+    }
+}
+
+#endif /* GLADOS_FFT_PLAN_CACHE_H_ */
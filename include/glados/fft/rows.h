@@ -0,0 +1,194 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_FFT_ROWS_H_
+#define GLADOS_FFT_ROWS_H_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include <glados/bits/memory_location.h>
+#include <glados/bits/pitched_ptr.h>
+#include <glados/fft/plan.h>
+#include <glados/fft/plan_cache.h>
+
+namespace glados
+{
+    namespace fft
+    {
+        /*
+         * One 1D transform per row of a 2D or 3D block, in the shape of cufftPlanMany's arguments.
+         * The rows of a 3D block are counted through all of its slices.
+         */
+        struct row_batch
+        {
+            int n[1];
+            int inembed[1];
+            int istride;
+            int idist;
+            int onembed[1];
+            int ostride;
+            int odist;
+            int batch;
+        };
+
+        namespace detail
+        {
+            template <class P, class = void>
+            struct is_pitched : std::false_type {};
+
+            template <class P>
+            struct is_pitched<P, typename std::enable_if<P::pitched_memory>::type> : std::true_type {};
+
+            template <class P, class = void>
+            struct is_host : std::true_type {}; // plain pointers don't tell
+
+            template <class P>
+            struct is_host<P, typename std::enable_if<P::mem_location != memory_location::host>::type> : std::false_type {};
+
+            template <class P>
+            struct element_of { using type = typename P::element_type; };
+
+            template <class T>
+            struct element_of<pitched_ptr<T>> { using type = T; };
+
+            template <class P>
+            auto data_of(const P& p) noexcept -> typename element_of<P>::type*
+            {
+                return p.get();
+            }
+
+            template <class T>
+            auto data_of(const pitched_ptr<T>& p) noexcept -> T*
+            {
+                return p.ptr();
+            }
+
+            template <class P>
+            auto pitch_of(const P& p, std::size_t) noexcept -> typename std::enable_if<is_pitched<P>::value, std::size_t>::type
+            {
+                return p.pitch();
+            }
+
+            template <class P>
+            auto pitch_of(const P&, std::size_t row_bytes) noexcept -> typename std::enable_if<!is_pitched<P>::value, std::size_t>::type
+            {
+                return row_bytes;
+            }
+
+            template <class T>
+            auto pitch_of(const pitched_ptr<T>& p, std::size_t) noexcept -> std::size_t
+            {
+                return p.pitch();
+            }
+
+            // real rows hold x values, complex rows of a real transform x / 2 + 1
+            template <class E, class Other>
+            constexpr auto row_width(std::size_t x) noexcept -> std::size_t
+            {
+                return (!std::is_floating_point<E>::value && std::is_floating_point<Other>::value) ? x / 2 + 1 : x;
+            }
+
+            template <class E>
+            auto row_distance(std::size_t pitch, std::size_t width) -> int
+            {
+                if(pitch % sizeof(E) != 0)
+                    throw std::invalid_argument{"glados::fft::rows: the pitch is not a multiple of the element size"};
+                if(pitch / sizeof(E) < width)
+                    throw std::invalid_argument{"glados::fft::rows: the pitch is smaller than a row"};
+                if(pitch / sizeof(E) > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+                    throw std::invalid_argument{"glados::fft::rows: the pitch is too large"};
+
+                return static_cast<int>(pitch / sizeof(E));
+            }
+        }
+
+        /*
+         * Derives the batch of row transforms of length x over the y * z rows of in and out from
+         * their pitches. Unpitched pointers count as dense rows.
+         */
+        template <class I, class O>
+        auto make_row_batch(const I& in, const O& out, std::size_t x, std::size_t y, std::size_t z = 1) -> row_batch
+        {
+            using in_type = typename detail::element_of<I>::type;
+            using out_type = typename detail::element_of<O>::type;
+
+            if(x > static_cast<std::size_t>(std::numeric_limits<int>::max())
+                || y * z > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+                throw std::invalid_argument{"glados::fft::rows: too many elements"};
+
+            auto in_width = detail::row_width<in_type, out_type>(x);
+            auto out_width = detail::row_width<out_type, in_type>(x);
+            auto idist = detail::row_distance<in_type>(detail::pitch_of(in, in_width * sizeof(in_type)), in_width);
+            auto odist = detail::row_distance<out_type>(detail::pitch_of(out, out_width * sizeof(out_type)), out_width);
+
+            return row_batch{{static_cast<int>(x)}, {idist}, 1, idist, {odist}, 1, odist, static_cast<int>(y * z)};
+        }
+
+        // the plan for a row batch from the process-wide cache; works for cufft::plan as well
+        template <class Plan>
+        auto row_plan(row_batch b) -> std::shared_ptr<Plan>
+        {
+            return plan_cache<Plan>::instance().get(1, b.n, b.inembed, b.istride, b.idist, b.onembed, b.ostride, b.odist, b.batch);
+        }
+
+        /*
+         * Transforms every row of a 2D or 3D host block in one batched call, e.g. all detector rows
+         * of a projection for ramp filtering. Real-to-complex and complex-to-real are told apart by
+         * the element types, complex-to-complex transforms take a direction. The transforms run on
+         * the CPU; device blocks go through row_plan<cufft::plan<...>> instead.
+         */
+        template <class I, class O>
+        auto transform_rows(I& in, O& out, std::size_t x, std::size_t y, std::size_t z = 1)
+        -> typename std::enable_if<!std::is_same<typename detail::element_of<I>::type, typename detail::element_of<O>::type>::value>::type
+        {
+            static_assert(detail::is_host<I>::value && detail::is_host<O>::value,
+                          "transform_rows runs on the CPU, transform device memory with row_plan<cufft::plan<...>>.");
+
+            using in_type = typename detail::element_of<I>::type;
+            using out_type = typename detail::element_of<O>::type;
+            using plan_type = plan<detail::type_chooser<in_type, out_type>::value>;
+
+            auto p = row_plan<plan_type>(make_row_batch(in, out, x, y, z));
+            p->execute(detail::data_of(in), detail::data_of(out));
+        }
+
+        template <class I, class O>
+        auto transform_rows(I& in, O& out, int direction, std::size_t x, std::size_t y, std::size_t z = 1)
+        -> typename std::enable_if<std::is_same<typename detail::element_of<I>::type, typename detail::element_of<O>::type>::value>::type
+        {
+            static_assert(detail::is_host<I>::value && detail::is_host<O>::value,
+                          "transform_rows runs on the CPU, transform device memory with row_plan<cufft::plan<...>>.");
+
+            using element_type = typename detail::element_of<I>::type;
+            using plan_type = plan<detail::type_chooser<element_type, element_type>::value>;
+
+            auto p = row_plan<plan_type>(make_row_batch(in, out, x, y, z));
+            p->execute(detail::data_of(in), detail::data_of(out), direction);
+        }
+    }
+}
+
+#endif /* GLADOS_FFT_ROWS_H_ */
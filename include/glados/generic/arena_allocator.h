@@ -0,0 +1,344 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_ARENA_ALLOCATOR_H_
+#define GLADOS_GENERIC_ARENA_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * Monotonic buffer for scratch memory. Allocations bump a pointer through large chunks and
+         * are never freed one by one; reset() makes the whole arena available again while keeping
+         * its chunks, release() gives the chunks back to the heap. Requests larger than a chunk get
+         * a chunk of their own. An arena is not thread-safe, use one per stage or per thread.
+         */
+        class arena
+        {
+            public:
+                static constexpr auto default_chunk_size = std::size_t{1} << 20;
+
+                explicit arena(std::size_t chunk_size = default_chunk_size)
+                : chunk_size_{chunk_size}
+                {}
+
+                arena(arena&& other) noexcept = default;
+                auto operator=(arena&& other) noexcept -> arena& = default;
+
+                arena(const arena& other) = delete;
+                auto operator=(const arena& other) -> arena& = delete;
+
+                ~arena() = default;
+
+                auto allocate(std::size_t bytes, std::size_t alignment) -> void*
+                {
+                    if(current_ < chunks_.size())
+                    {
+                        auto p = bump(chunks_[current_], bytes, alignment);
+                        if(p != nullptr)
+                            return p;
+                    }
+
+                    // move on to the next kept chunk which is large enough, otherwise add one
+                    while(++current_ < chunks_.size())
+                    {
+                        auto p = bump(chunks_[current_], bytes, alignment);
+                        if(p != nullptr)
+                            return p;
+                    }
+
+                    auto size = std::max(chunk_size_, bytes + alignment);
+                    chunks_.push_back(chunk{std::unique_ptr<unsigned char[]>{new unsigned char[size]}, size, 0});
+                    current_ = chunks_.size() - 1;
+                    return bump(chunks_[current_], bytes, alignment);
+                }
+
+                // every pointer handed out before becomes invalid
+                auto reset() noexcept -> void
+                {
+                    for(auto&& c : chunks_)
+                        c.used = 0;
+                    current_ = 0;
+                }
+
+                auto release() noexcept -> void
+                {
+                    chunks_.clear();
+                    current_ = 0;
+                }
+
+                auto used() const noexcept -> std::size_t
+                {
+                    auto ret = std::size_t{0};
+                    for(auto&& c : chunks_)
+                        ret += c.used;
+                    return ret;
+                }
+
+                auto capacity() const noexcept -> std::size_t
+                {
+                    auto ret = std::size_t{0};
+                    for(auto&& c : chunks_)
+                        ret += c.size;
+                    return ret;
+                }
+
+            private:
+                struct chunk
+                {
+                    std::unique_ptr<unsigned char[]> data;
+                    std::size_t size;
+                    std::size_t used;
+                };
+
+                static auto bump(chunk& c, std::size_t bytes, std::size_t alignment) noexcept -> void*
+                {
+                    auto base = reinterpret_cast<std::uintptr_t>(c.data.get());
+                    auto start = (base + c.used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+                    auto end = start + bytes;
+                    if(end > base + c.size)
+                        return nullptr;
+
+                    c.used = end - base;
+                    return reinterpret_cast<void*>(start);
+                }
+
+            private:
+                std::size_t chunk_size_;
+                std::vector<chunk> chunks_;
+                std::size_t current_ = 0;
+        };
+
+        namespace detail
+        {
+            // the memory of an arena is only reclaimed as a whole, so the elements must not need destruction
+            template <class T>
+            auto arena_construct(arena& a, std::size_t n) -> T*
+            {
+                static_assert(std::is_trivially_destructible<T>::value, "arena_allocator only supports trivially destructible types");
+
+                auto p = static_cast<T*>(a.allocate(n * sizeof(T), alignof(T)));
+                for(auto i = std::size_t{0}; i < n; ++i)
+                    ::new(static_cast<void*>(p + i)) T;
+                return p;
+            }
+        }
+
+        /*
+         * Allocator interface to an arena. deallocate() does nothing, the memory comes back when the
+         * arena is reset. Copies and rebinds share the arena, which has to outlive them.
+         */
+        template <class T, memory_layout ml>
+        class arena_allocator {};
+
+        template <class T>
+        class arena_allocator<T, memory_layout::pointer_1D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_1D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = arena_allocator<U, mem_layout>;
+                };
+
+                arena_allocator(arena& a) noexcept : arena_{&a} {}
+                arena_allocator(const arena_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                arena_allocator(const arena_allocator<U, uml>& other) noexcept
+                : arena_{&other.get_arena()}
+                {
+                    static_assert(mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~arena_allocator() = default;
+
+                auto allocate(size_type n) -> pointer
+                {
+                    return detail::arena_construct<T>(*arena_, n);
+                }
+
+                auto deallocate(pointer, size_type = 0) noexcept -> void {}
+
+                auto get_arena() const noexcept -> arena&
+                {
+                    return *arena_;
+                }
+
+            private:
+                arena* arena_;
+        };
+
+        template <class T>
+        class arena_allocator<T, memory_layout::pointer_2D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = arena_allocator<U, mem_layout>;
+                };
+
+                arena_allocator(arena& a) noexcept : arena_{&a} {}
+                arena_allocator(const arena_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                arena_allocator(const arena_allocator<U, uml>& other) noexcept
+                : arena_{&other.get_arena()}
+                {
+                    static_assert(mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~arena_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    return detail::arena_construct<T>(*arena_, x * y);
+                }
+
+                auto deallocate(pointer, size_type = 0, size_type = 0) noexcept -> void {}
+
+                auto get_arena() const noexcept -> arena&
+                {
+                    return *arena_;
+                }
+
+            private:
+                arena* arena_;
+        };
+
+        template <class T>
+        class arena_allocator<T, memory_layout::pointer_3D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = arena_allocator<U, mem_layout>;
+                };
+
+                arena_allocator(arena& a) noexcept : arena_{&a} {}
+                arena_allocator(const arena_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                arena_allocator(const arena_allocator<U, uml>& other) noexcept
+                : arena_{&other.get_arena()}
+                {
+                    static_assert(mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~arena_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    return detail::arena_construct<T>(*arena_, x * y * z);
+                }
+
+                auto deallocate(pointer, size_type = 0, size_type = 0, size_type = 0) noexcept -> void {}
+
+                auto get_arena() const noexcept -> arena&
+                {
+                    return *arena_;
+                }
+
+            private:
+                arena* arena_;
+        };
+
+        template <class T, class U, memory_layout ml>
+        auto operator==(const arena_allocator<T, ml>& lhs, const arena_allocator<U, ml>& rhs) noexcept -> bool
+        {
+            return &lhs.get_arena() == &rhs.get_arena();
+        }
+
+        template <class T, class U, memory_layout ml>
+        auto operator!=(const arena_allocator<T, ml>& lhs, const arena_allocator<U, ml>& rhs) noexcept -> bool
+        {
+            return !(lhs == rhs);
+        }
+    }
+}
+
+#endif /* GLADOS_GENERIC_ARENA_ALLOCATOR_H_ */
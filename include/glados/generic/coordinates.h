@@ -0,0 +1,64 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_COORDINATES_H_
+#define GLADOS_GENERIC_COORDINATES_H_
+
+namespace glados
+{
+    namespace generic
+    {
+        namespace detail
+        {
+            struct coordinates
+            {
+                unsigned int x;
+                unsigned int y;
+                unsigned int z;
+            };
+
+            // set by generic::launch for kernels which don't take their coordinates as arguments
+            inline auto current_coordinates() noexcept -> coordinates&
+            {
+                static thread_local auto c = coordinates{0u, 0u, 0u};
+                return c;
+            }
+        }
+
+        inline auto coord_x() noexcept -> unsigned int
+        {
+            return detail::current_coordinates().x;
+        }
+
+        inline auto coord_y() noexcept -> unsigned int
+        {
+            return detail::current_coordinates().y;
+        }
+
+        inline auto coord_z() noexcept -> unsigned int
+        {
+            return detail::current_coordinates().z;
+        }
+    }
+}
+
+#endif /* GLADOS_GENERIC_COORDINATES_H_ */
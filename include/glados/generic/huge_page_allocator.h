@@ -0,0 +1,348 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_HUGE_PAGE_ALLOCATOR_H_
+#define GLADOS_GENERIC_HUGE_PAGE_ALLOCATOR_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        // pages are placed on the node of the thread which touches them first
+        constexpr auto first_touch = -1;
+
+        namespace detail
+        {
+            constexpr auto huge_page_size = std::size_t{2} << 20;
+            constexpr auto min_page_size = std::size_t{4096};
+
+            /*
+             * The lengths of the mappings, keyed by their address. Keeping them out of the blocks
+             * lets a block start right at its (huge) page boundary, and pools may still return
+             * blocks without their shape.
+             */
+            class mapping_table
+            {
+                public:
+                    static auto instance() -> mapping_table&
+                    {
+                        static mapping_table table;
+                        return table;
+                    }
+
+                    auto add(void* mem, std::size_t len) -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        lengths_.emplace(mem, len);
+                    }
+
+                    // returns 0 for unknown addresses
+                    auto remove(void* mem) noexcept -> std::size_t
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        auto it = lengths_.find(mem);
+                        if(it == std::end(lengths_))
+                            return 0;
+
+                        auto len = it->second;
+                        lengths_.erase(it);
+                        return len;
+                    }
+
+                private:
+                    std::mutex mutex_;
+                    std::unordered_map<void*, std::size_t> lengths_;
+            };
+
+            inline auto map_pages(std::size_t bytes, int node) -> void*
+            {
+                auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+                auto len = (bytes + page - 1) & ~(page - 1);
+                if(len == 0)
+                    len = page;
+
+                // large blocks are mapped in whole huge pages, over-mapped so the mapping can start at a huge page boundary
+                auto slack = std::size_t{0};
+                if(len >= huge_page_size)
+                {
+                    len = (len + huge_page_size - 1) & ~(huge_page_size - 1);
+                    slack = huge_page_size;
+                }
+
+                auto raw = mmap(nullptr, len + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if(raw == MAP_FAILED)
+                    throw std::bad_alloc{};
+
+                auto addr = reinterpret_cast<std::uintptr_t>(raw);
+                auto base = (slack == 0) ? addr : (addr + slack - 1) & ~(slack - 1);
+                if(base != addr)
+                    munmap(raw, base - addr);
+                if(addr + len + slack != base + len)
+                    munmap(reinterpret_cast<void*>(base + len), addr + len + slack - (base + len));
+
+                auto mem = reinterpret_cast<void*>(base);
+#ifdef MADV_HUGEPAGE
+                // only advice, transparent huge pages may be disabled
+                if(slack != 0)
+                    madvise(mem, len, MADV_HUGEPAGE);
+#endif
+
+#if defined(__linux__)
+                if(node != first_touch)
+                {
+                    // nothing has touched the pages yet, so all of them follow the policy
+                    auto mask = 1ul << static_cast<unsigned>(node);
+                    if(syscall(SYS_mbind, mem, len, MPOL_BIND, &mask, sizeof(mask) * 8 + 1, 0) != 0)
+                    {
+                        auto err = errno;
+                        munmap(mem, len);
+                        throw std::system_error{err, std::system_category(), "glados::generic::huge_page_allocator: mbind failed"};
+                    }
+                }
+#else
+                static_cast<void>(node);
+#endif
+
+                try
+                {
+                    mapping_table::instance().add(mem, len);
+                }
+                catch(...)
+                {
+                    munmap(mem, len);
+                    throw;
+                }
+                return mem;
+            }
+
+            inline auto unmap_pages(void* p) noexcept -> void
+            {
+                if(p == nullptr)
+                    return;
+
+                auto len = mapping_table::instance().remove(p);
+                if(len != 0)
+                    munmap(p, len);
+            }
+
+            template <class T, int Node>
+            auto huge_page_new(std::size_t n) -> T*
+            {
+                static_assert(std::is_trivially_destructible<T>::value, "huge_page_allocator only supports trivially destructible types");
+                static_assert(alignof(T) <= min_page_size, "huge_page_allocator can't align T");
+                static_assert((Node >= first_touch) && (Node < static_cast<int>(sizeof(unsigned long) * 8)), "Invalid NUMA node");
+
+                auto p = static_cast<T*>(map_pages(n * sizeof(T), Node));
+                for(auto i = std::size_t{0}; i < n; ++i)
+                    ::new(static_cast<void*>(p + i)) T;
+                return p;
+            }
+        }
+
+        /*
+         * Host allocator for large buffers which maps its blocks directly with mmap. Blocks of at
+         * least 2 MiB start at a huge page boundary, are mapped in whole huge pages and are advised
+         * to use transparent huge pages, which saves TLB misses when a volume is traversed. With
+         * NumaNode the pages are bound to that node (Linux only), otherwise they go wherever they
+         * are touched first, so initialise a block on the threads which are going to work on it.
+         * Every block costs at least one page.
+         */
+        template <class T, memory_layout ml, int NumaNode = first_touch>
+        class huge_page_allocator {};
+
+        template <class T, int NumaNode>
+        class huge_page_allocator<T, memory_layout::pointer_1D, NumaNode>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_1D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto numa_node = NumaNode;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = huge_page_allocator<U, mem_layout, NumaNode>;
+                };
+
+                huge_page_allocator() noexcept = default;
+                huge_page_allocator(const huge_page_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml, int un>
+                huge_page_allocator(const huge_page_allocator<U, uml, un>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml && NumaNode == un, "Attempting to copy incompatible allocator");
+                }
+
+                ~huge_page_allocator() = default;
+
+                auto allocate(size_type n) -> pointer
+                {
+                    return detail::huge_page_new<T, NumaNode>(n);
+                }
+
+                // the length of the mapping is looked up by address, the sizes aren't needed
+                auto deallocate(pointer p, size_type = 0) noexcept -> void
+                {
+                    detail::unmap_pages(p);
+                }
+        };
+
+        template <class T, int NumaNode>
+        class huge_page_allocator<T, memory_layout::pointer_2D, NumaNode>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto numa_node = NumaNode;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = huge_page_allocator<U, mem_layout, NumaNode>;
+                };
+
+                huge_page_allocator() noexcept = default;
+                huge_page_allocator(const huge_page_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml, int un>
+                huge_page_allocator(const huge_page_allocator<U, uml, un>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml && NumaNode == un, "Attempting to copy incompatible allocator");
+                }
+
+                ~huge_page_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    return detail::huge_page_new<T, NumaNode>(x * y);
+                }
+
+                // the length of the mapping is looked up by address, the sizes aren't needed
+                auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    detail::unmap_pages(p);
+                }
+        };
+
+        template <class T, int NumaNode>
+        class huge_page_allocator<T, memory_layout::pointer_3D, NumaNode>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto numa_node = NumaNode;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = huge_page_allocator<U, mem_layout, NumaNode>;
+                };
+
+                huge_page_allocator() noexcept = default;
+                huge_page_allocator(const huge_page_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml, int un>
+                huge_page_allocator(const huge_page_allocator<U, uml, un>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml && NumaNode == un, "Attempting to copy incompatible allocator");
+                }
+
+                ~huge_page_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    return detail::huge_page_new<T, NumaNode>(x * y * z);
+                }
+
+                // the length of the mapping is looked up by address, the sizes aren't needed
+                auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    detail::unmap_pages(p);
+                }
+        };
+    }
+}
+
+#endif /* GLADOS_GENERIC_HUGE_PAGE_ALLOCATOR_H_ */
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_LAUNCH_H_
+#define GLADOS_GENERIC_LAUNCH_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <type_traits>
+
+#include <glados/generic/coordinates.h>
+#include <glados/generic/thread_pool.h>
+#include <glados/pipeline/work_stealing_queue.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * Extent of the tiles a launch is split into. A tile is the unit of work handed to a thread,
+         * its elements are visited row by row.
+         */
+        struct block_shape
+        {
+            constexpr explicit block_shape(std::size_t bx, std::size_t by = 1, std::size_t bz = 1) noexcept
+            : x{(bx == 0) ? 1 : bx}, y{(by == 0) ? 1 : by}, z{(bz == 0) ? 1 : bz}
+            {}
+
+            std::size_t x;
+            std::size_t y;
+            std::size_t z;
+        };
+
+        // about 16 KiB of floats per tile, so a few input and output tiles stay in L1/L2
+        constexpr auto default_block_1d = block_shape{4096};
+        constexpr auto default_block_2d = block_shape{256, 16};
+        constexpr auto default_block_3d = block_shape{64, 8, 8};
+
+        namespace detail
+        {
+            template <int Dims>
+            using dims = std::integral_constant<int, Dims>;
+
+            // kernels either take their coordinates or ask for them through coord_x() etc.
+            template <class F>
+            auto call(F& f, std::size_t x, std::size_t, std::size_t, dims<1>, int) -> decltype(f(x), void())
+            {
+                f(x);
+            }
+
+            template <class F>
+            auto call(F& f, std::size_t x, std::size_t y, std::size_t, dims<2>, int) -> decltype(f(x, y), void())
+            {
+                f(x, y);
+            }
+
+            template <class F>
+            auto call(F& f, std::size_t x, std::size_t y, std::size_t z, dims<3>, int) -> decltype(f(x, y, z), void())
+            {
+                f(x, y, z);
+            }
+
+            template <class F, int Dims>
+            auto call(F& f, std::size_t x, std::size_t y, std::size_t z, dims<Dims>, long) -> decltype(f(), void())
+            {
+                auto& c = current_coordinates();
+                c.x = static_cast<unsigned int>(x);
+                c.y = static_cast<unsigned int>(y);
+                c.z = static_cast<unsigned int>(z);
+                f();
+            }
+
+            /*
+             * Shared by the calling thread and the pool helpers. A helper which starts after all tiles
+             * have been taken leaves without touching the kernel, so the caller only waits for the
+             * tiles, not for the helpers.
+             */
+            template <class F, int Dims>
+            class tiled_launch
+            {
+                public:
+                    tiled_launch(F& f, std::size_t w, std::size_t h, std::size_t d, block_shape b,
+                                    std::size_t workers, std::queue<std::size_t> tiles)
+                    : f_(f), w_{w}, h_{h}, d_{d}, b_{b}
+                    , tiles_x_{(w + b.x - 1) / b.x}, tiles_y_{(h + b.y - 1) / b.y}
+                    , total_{tiles.size()}
+                    , queue_{workers, std::move(tiles)}
+                    {}
+
+                    auto work() -> void
+                    {
+                        auto index = next_worker_.fetch_add(1, std::memory_order_relaxed);
+                        if(index >= queue_.workers())
+                            return;
+
+                        auto worker = queue_.get_worker(index);
+                        auto tile = std::size_t{};
+                        while(worker.try_pop(tile))
+                        {
+                            if(!failed_.load(std::memory_order_relaxed))
+                            {
+                                try
+                                {
+                                    run(tile);
+                                }
+                                catch(...)
+                                {
+                                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                                    if(error_ == nullptr)
+                                        error_ = std::current_exception();
+                                    failed_.store(true, std::memory_order_relaxed);
+                                }
+                            }
+
+                            if(done_.fetch_add(1, std::memory_order_acq_rel) + 1 == total_)
+                            {
+                                auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                                cv_.notify_all();
+                            }
+                        }
+                    }
+
+                    auto wait() -> void
+                    {
+                        {
+                            auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                            cv_.wait(lock, [this]() { return done_.load(std::memory_order_acquire) == total_; });
+                        }
+
+                        if(error_ != nullptr)
+                            std::rethrow_exception(error_);
+                    }
+
+                private:
+                    auto run(std::size_t tile) -> void
+                    {
+                        auto x0 = (tile % tiles_x_) * b_.x;
+                        auto y0 = (tile / tiles_x_ % tiles_y_) * b_.y;
+                        auto z0 = (tile / tiles_x_ / tiles_y_) * b_.z;
+
+                        auto x1 = std::min(x0 + b_.x, w_);
+                        auto y1 = std::min(y0 + b_.y, h_);
+                        auto z1 = std::min(z0 + b_.z, d_);
+
+                        for(auto z = z0; z < z1; ++z)
+                            for(auto y = y0; y < y1; ++y)
+                                for(auto x = x0; x < x1; ++x)
+                                    call(f_, x, y, z, dims<Dims>{}, 0);
+                    }
+
+                private:
+                    F& f_;
+                    std::size_t w_;
+                    std::size_t h_;
+                    std::size_t d_;
+                    block_shape b_;
+                    std::size_t tiles_x_;
+                    std::size_t tiles_y_;
+                    std::size_t total_;
+                    pipeline::work_stealing_queue<std::size_t> queue_;
+                    std::atomic<std::size_t> next_worker_{0};
+                    std::atomic<std::size_t> done_{0};
+                    std::atomic<bool> failed_{false};
+                    std::mutex mutex_;
+                    std::condition_variable cv_;
+                    std::exception_ptr error_;
+            };
+
+            template <int Dims, class F>
+            auto launch(thread_pool& pool, std::size_t w, std::size_t h, std::size_t d, F& f, block_shape b) -> void
+            {
+                auto total = ((w + b.x - 1) / b.x) * ((h + b.y - 1) / b.y) * ((d + b.z - 1) / b.z);
+                if(total == 0)
+                    return;
+
+                auto tiles = std::queue<std::size_t>{};
+                for(auto t = std::size_t{0}; t < total; ++t)
+                    tiles.push(t);
+
+                // the calling thread is one of the workers, so launching from a pool thread doesn't deadlock
+                auto workers = std::min(pool.size() + 1, total);
+                auto state = std::make_shared<tiled_launch<F, Dims>>(f, w, h, d, b, workers, std::move(tiles));
+                for(auto i = std::size_t{1}; i < workers; ++i)
+                    pool.submit([state]() { state->work(); });
+
+                state->work();
+                state->wait();
+            }
+        }
+
+        /*
+         * Host counterparts of cuda::launch. The kernel is called once per element, either as
+         * f(x[, y[, z]]) or as f() reading coord_x() etc. Unlike on the GPU there is no excess
+         * grid, so a kernel doesn't need to check its coordinates against the input size. The
+         * domain is split into tiles of the given block shape, which are handed out in contiguous
+         * runs to the calling thread and the pool's threads; a thread which runs out of tiles steals
+         * from the others. The first exception thrown by the kernel is rethrown once all tiles are
+         * done, tiles not yet started are skipped.
+         */
+        template <class F>
+        auto launch(thread_pool& pool, std::size_t input_width, F&& f, block_shape b = default_block_1d) -> void
+        {
+            detail::launch<1>(pool, input_width, 1, 1, f, b);
+        }
+
+        template <class F>
+        auto launch(thread_pool& pool, std::size_t input_width, std::size_t input_height, F&& f,
+                    block_shape b = default_block_2d) -> void
+        {
+            detail::launch<2>(pool, input_width, input_height, 1, f, b);
+        }
+
+        template <class F>
+        auto launch(thread_pool& pool, std::size_t input_width, std::size_t input_height, std::size_t input_depth, F&& f,
+                    block_shape b = default_block_3d) -> void
+        {
+            detail::launch<3>(pool, input_width, input_height, input_depth, f, b);
+        }
+    }
+}
+
+#endif /* GLADOS_GENERIC_LAUNCH_H_ */
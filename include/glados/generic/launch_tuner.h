@@ -0,0 +1,244 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_LAUNCH_TUNER_H_
+#define GLADOS_GENERIC_LAUNCH_TUNER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glados/generic/launch.h>
+#include <glados/generic/thread_pool.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * Picks the block shape of generic::launch per kernel by measurement. The first launch of a
+         * kernel name runs the kernel once per candidate shape and keeps the fastest, later launches
+         * use the stored shape directly. The kernel therefore has to give the same result when it
+         * runs several times, e.g. by only writing its output.
+         *
+         * Any launcher can be tuned through launch(kernel, w, h, d, candidates, l): l(b) has to run the
+         * whole kernel with block shape b and return once it is done, e.g. after synchronizing its
+         * stream. The overloads taking a thread_pool tune generic::launch this way.
+         *
+         * The shapes can be written to a file and read back, so the trials are paid once per machine.
+         * The file holds one kernel per line as "x y z name"; unreadable lines are skipped and tuned
+         * again.
+         */
+        class launch_tuner
+        {
+            public:
+                launch_tuner() = default;
+
+                // reads path if it exists, save() writes back to it
+                explicit launch_tuner(std::string path, unsigned int trials = 2)
+                : path_{std::move(path)}, trials_{std::max(trials, 1u)}
+                {
+                    auto file = std::ifstream{path_};
+                    if(file)
+                        read(file);
+                }
+
+                launch_tuner(const launch_tuner&) = delete;
+                auto operator=(const launch_tuner&) -> launch_tuner& = delete;
+
+                template <class F>
+                auto launch(thread_pool& pool, const std::string& kernel, std::size_t input_width, F&& f) -> void
+                {
+                    launch(kernel, input_width, 1, 1, candidates_1d(), [&](block_shape b) {
+                        generic::launch(pool, input_width, f, b);
+                    });
+                }
+
+                template <class F>
+                auto launch(thread_pool& pool, const std::string& kernel, std::size_t input_width, std::size_t input_height,
+                            F&& f) -> void
+                {
+                    launch(kernel, input_width, input_height, 1, candidates_2d(), [&](block_shape b) {
+                        generic::launch(pool, input_width, input_height, f, b);
+                    });
+                }
+
+                template <class F>
+                auto launch(thread_pool& pool, const std::string& kernel, std::size_t input_width, std::size_t input_height,
+                            std::size_t input_depth, F&& f) -> void
+                {
+                    launch(kernel, input_width, input_height, input_depth, candidates_3d(), [&](block_shape b) {
+                        generic::launch(pool, input_width, input_height, input_depth, f, b);
+                    });
+                }
+
+                /*
+                 * Runs l with the stored shape of kernel, or tunes it first: l is called with every
+                 * candidate clamped to the w x h x d input and the fastest candidate is stored.
+                 */
+                template <class Launcher>
+                auto launch(const std::string& kernel, std::size_t w, std::size_t h, std::size_t d,
+                            const std::vector<block_shape>& candidates, Launcher&& l) -> void
+                {
+                    if(candidates.empty())
+                        throw std::invalid_argument{"glados::generic::launch_tuner: no candidate shapes"};
+
+                    auto b = block_shape{1};
+                    if((w * h * d == 0) || try_get(kernel, b))
+                    {
+                        l(b);
+                        return;
+                    }
+
+                    /*
+                     * Shapes larger than the input collapse onto the same tiling and are tried once.
+                     * The candidate itself is stored, not its clamp, as later launches of the kernel
+                     * may cover larger inputs.
+                     */
+                    auto shapes = std::vector<std::pair<block_shape, block_shape>>{}; // clamped, candidate
+                    for(auto&& c : candidates)
+                    {
+                        auto s = block_shape{std::min(c.x, w), std::min(c.y, h), std::min(c.z, d)};
+                        auto same = [&s](const std::pair<block_shape, block_shape>& o) {
+                            return o.first.x == s.x && o.first.y == s.y && o.first.z == s.z;
+                        };
+                        if(std::find_if(std::begin(shapes), std::end(shapes), same) == std::end(shapes))
+                            shapes.emplace_back(s, c);
+                    }
+
+                    // the first run pays for page faults and cold caches, keep it out of the comparison
+                    l(shapes.front().first);
+
+                    auto best = shapes.front().second;
+                    auto best_time = std::chrono::steady_clock::duration::max();
+                    for(auto&& s : shapes)
+                    {
+                        for(auto t = 0u; t < trials_; ++t)
+                        {
+                            auto start = std::chrono::steady_clock::now();
+                            l(s.first);
+                            auto time = std::chrono::steady_clock::now() - start;
+                            if(time < best_time)
+                            {
+                                best = s.second;
+                                best_time = time;
+                            }
+                        }
+                    }
+
+                    set(kernel, best);
+                }
+
+                auto try_get(const std::string& kernel, block_shape& b) const -> bool
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    auto it = shapes_.find(kernel);
+                    if(it == std::end(shapes_))
+                        return false;
+
+                    b = it->second;
+                    return true;
+                }
+
+                auto set(const std::string& kernel, block_shape b) -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    shapes_.erase(kernel);
+                    shapes_.emplace(kernel, b);
+                }
+
+                auto read(std::istream& is) -> void
+                {
+                    auto line = std::string{};
+                    while(std::getline(is, line))
+                    {
+                        auto ls = std::istringstream{line};
+                        auto x = std::size_t{};
+                        auto y = std::size_t{};
+                        auto z = std::size_t{};
+                        auto name = std::string{};
+                        if(!(ls >> x >> y >> z) || !std::getline(ls >> std::ws, name) || name.empty())
+                            continue;
+
+                        set(name, block_shape{x, y, z});
+                    }
+                }
+
+                auto write(std::ostream& os) const -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    for(auto&& s : shapes_)
+                        os << s.second.x << ' ' << s.second.y << ' ' << s.second.z << ' ' << s.first << '\n';
+                }
+
+                auto save() const -> void
+                {
+                    if(path_.empty())
+                        throw std::logic_error{"glados::generic::launch_tuner: no file to save to"};
+                    save(path_);
+                }
+
+                auto save(const std::string& path) const -> void
+                {
+                    auto file = std::ofstream{path};
+                    if(!file)
+                        throw std::runtime_error{"glados::generic::launch_tuner: cannot open " + path};
+                    write(file);
+                }
+
+                static auto candidates_1d() -> std::vector<block_shape>
+                {
+                    return {block_shape{1024}, block_shape{4096}, block_shape{16384}, block_shape{65536}};
+                }
+
+                static auto candidates_2d() -> std::vector<block_shape>
+                {
+                    return {block_shape{32, 32}, block_shape{64, 16}, block_shape{256, 16}, block_shape{1024, 4},
+                            block_shape{4096, 1}};
+                }
+
+                static auto candidates_3d() -> std::vector<block_shape>
+                {
+                    return {block_shape{16, 16, 4}, block_shape{32, 8, 8}, block_shape{64, 8, 8}, block_shape{256, 4, 4},
+                            block_shape{1024, 4, 1}};
+                }
+
+            private:
+                std::string path_;
+                unsigned int trials_ = 2;
+                std::map<std::string, block_shape> shapes_;
+                mutable std::mutex mutex_;
+        };
+    }
+}
+
+#endif /* GLADOS_GENERIC_LAUNCH_TUNER_H_ */
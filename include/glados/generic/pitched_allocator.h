@@ -0,0 +1,339 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_PITCHED_ALLOCATOR_H_
+#define GLADOS_GENERIC_PITCHED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+#include <glados/bits/pitched_ptr.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * Owns a pitched host block. Follows the interface of the pitched cuda::unique_ptr, so the
+         * copy and fill policies treat both alike.
+         */
+        template <class T, class Deleter>
+        class pitched_unique_ptr
+        {
+            public:
+                using pointer = pitched_ptr<T>;
+                using element_type = T;
+                using deleter_type = Deleter;
+
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto pitched_memory = true;
+                static constexpr auto pinned_memory = false;
+
+                pitched_unique_ptr() noexcept : ptr_{nullptr}, pitch_{0u}, deleter_{} {}
+                pitched_unique_ptr(std::nullptr_t) noexcept : ptr_{nullptr}, pitch_{0u}, deleter_{} {}
+
+                explicit pitched_unique_ptr(pointer ptr) noexcept
+                : ptr_{ptr.ptr()}, pitch_{ptr.pitch()}, deleter_{}
+                {}
+
+                pitched_unique_ptr(pointer ptr, Deleter d) noexcept
+                : ptr_{ptr.ptr()}, pitch_{ptr.pitch()}, deleter_(std::move(d))
+                {}
+
+                pitched_unique_ptr(pitched_unique_ptr&& other) noexcept
+                : ptr_{other.ptr_}, pitch_{other.pitch_}, deleter_(std::move(other.deleter_))
+                {
+                    other.ptr_ = nullptr;
+                    other.pitch_ = 0;
+                }
+
+                auto operator=(pitched_unique_ptr&& other) noexcept -> pitched_unique_ptr&
+                {
+                    reset();
+                    std::swap(ptr_, other.ptr_);
+                    std::swap(pitch_, other.pitch_);
+                    deleter_ = std::move(other.deleter_);
+                    return *this;
+                }
+
+                auto operator=(std::nullptr_t) noexcept -> pitched_unique_ptr&
+                {
+                    reset();
+                    return *this;
+                }
+
+                pitched_unique_ptr(const pitched_unique_ptr&) = delete;
+                auto operator=(const pitched_unique_ptr&) -> pitched_unique_ptr& = delete;
+
+                ~pitched_unique_ptr()
+                {
+                    if(ptr_ != nullptr)
+                        deleter_(ptr_);
+                }
+
+                auto release() noexcept -> pointer
+                {
+                    auto ret = pointer{ptr_, pitch_};
+                    ptr_ = nullptr;
+                    pitch_ = 0;
+                    return ret;
+                }
+
+                auto reset(pointer ptr = pointer{nullptr}) noexcept -> void
+                {
+                    auto old_ptr = ptr_;
+                    ptr_ = ptr.ptr();
+                    pitch_ = ptr.pitch();
+
+                    if(old_ptr != nullptr)
+                        deleter_(old_ptr);
+                }
+
+                auto reset(std::nullptr_t) noexcept -> void
+                {
+                    reset(pointer{nullptr});
+                }
+
+                auto swap(pitched_unique_ptr& other) noexcept -> void
+                {
+                    std::swap(ptr_, other.ptr_);
+                    std::swap(pitch_, other.pitch_);
+                    std::swap(deleter_, other.deleter_);
+                }
+
+                auto get() const noexcept -> element_type*
+                {
+                    return ptr_;
+                }
+
+                auto get_deleter() noexcept -> deleter_type&
+                {
+                    return deleter_;
+                }
+
+                auto get_deleter() const noexcept -> const deleter_type&
+                {
+                    return deleter_;
+                }
+
+                explicit operator bool() const noexcept
+                {
+                    return ptr_ != nullptr;
+                }
+
+                auto pitch() const noexcept -> std::size_t
+                {
+                    return pitch_;
+                }
+
+                // rows of a 3D block are counted through all of its slices
+                auto row(std::size_t r) const noexcept -> element_type*
+                {
+                    return reinterpret_cast<element_type*>(reinterpret_cast<unsigned char*>(ptr_) + r * pitch_);
+                }
+
+            private:
+                element_type* ptr_;
+                std::size_t pitch_;
+                deleter_type deleter_;
+        };
+
+        template <class T, class Deleter>
+        auto operator==(const pitched_unique_ptr<T, Deleter>& p, std::nullptr_t) noexcept -> bool
+        {
+            return p.get() == nullptr;
+        }
+
+        template <class T, class Deleter>
+        auto operator!=(const pitched_unique_ptr<T, Deleter>& p, std::nullptr_t) noexcept -> bool
+        {
+            return p.get() != nullptr;
+        }
+
+        namespace detail
+        {
+            /*
+             * Rows are padded to a multiple of RowAlignment. A pitch which is a multiple of 512 bytes
+             * maps a column onto an eighth of the L1 sets or less, such rows get one more unit of
+             * padding.
+             */
+            constexpr auto round_up(std::size_t v, std::size_t multiple) noexcept -> std::size_t
+            {
+                return (v + multiple - 1) / multiple * multiple;
+            }
+
+            template <class T, std::size_t RowAlignment>
+            constexpr auto row_pitch(std::size_t x) noexcept -> std::size_t
+            {
+                return (round_up(x * sizeof(T), RowAlignment) % 512 == 0) ? round_up(x * sizeof(T), RowAlignment) + RowAlignment
+                                                                           : round_up(x * sizeof(T), RowAlignment);
+            }
+
+            template <class T, std::size_t RowAlignment>
+            auto pitched_new(std::size_t x, std::size_t rows) -> pitched_ptr<T>
+            {
+                static_assert(std::is_trivially_destructible<T>::value, "pitched_allocator only supports trivially destructible types");
+                static_assert((RowAlignment >= alignof(T)) && (RowAlignment % sizeof(void*) == 0) && ((RowAlignment & (RowAlignment - 1)) == 0),
+                              "RowAlignment must be a power of two, a multiple of sizeof(void*) and at least alignof(T)");
+
+                auto pitch = row_pitch<T, RowAlignment>(x);
+                auto mem = static_cast<void*>(nullptr);
+                if(posix_memalign(&mem, RowAlignment, (rows == 0) ? pitch : pitch * rows) != 0)
+                    throw std::bad_alloc{};
+
+                auto bytes = static_cast<unsigned char*>(mem);
+                for(auto r = std::size_t{0}; r < rows; ++r)
+                {
+                    auto row = reinterpret_cast<T*>(bytes + r * pitch);
+                    for(auto i = std::size_t{0}; i < x; ++i)
+                        ::new(static_cast<void*>(row + i)) T;
+                }
+                return pitched_ptr<T>{static_cast<T*>(mem), pitch};
+            }
+        }
+
+        /*
+         * Host allocator for 2D and 3D blocks whose rows start at a multiple of RowAlignment, 64
+         * bytes by default. Row-wise CPU kernels can use aligned vector loads on every row, and
+         * power-of-two widths are padded so columns don't thrash a few cache sets.
+         */
+        template <class T, memory_layout ml, std::size_t RowAlignment = 64>
+        class pitched_allocator {};
+
+        template <class T, std::size_t RowAlignment>
+        class pitched_allocator<T, memory_layout::pointer_2D, RowAlignment>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = true;
+
+                using value_type = T;
+                using pointer = pitched_ptr<value_type>;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = pitched_unique_ptr<T, Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = pitched_allocator<U, mem_layout, RowAlignment>;
+                };
+
+                pitched_allocator() noexcept = default;
+                pitched_allocator(const pitched_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml, std::size_t ua>
+                pitched_allocator(const pitched_allocator<U, uml, ua>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml && RowAlignment == ua, "Attempting to copy incompatible allocator");
+                }
+
+                ~pitched_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    return detail::pitched_new<T, RowAlignment>(x, y);
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    std::free(p.ptr());
+                }
+        };
+
+        template <class T, std::size_t RowAlignment>
+        class pitched_allocator<T, memory_layout::pointer_3D, RowAlignment>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = true;
+
+                using value_type = T;
+                using pointer = pitched_ptr<value_type>;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = pitched_unique_ptr<T, Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = pitched_allocator<U, mem_layout, RowAlignment>;
+                };
+
+                pitched_allocator() noexcept = default;
+                pitched_allocator(const pitched_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml, std::size_t ua>
+                pitched_allocator(const pitched_allocator<U, uml, ua>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml && RowAlignment == ua, "Attempting to copy incompatible allocator");
+                }
+
+                ~pitched_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    return detail::pitched_new<T, RowAlignment>(x, y * z);
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    std::free(p.ptr());
+                }
+        };
+
+        template <class T, std::size_t RowAlignment = 64>
+        auto make_unique_pitched(std::size_t x, std::size_t y) -> pitched_unique_ptr<T, decltype(&std::free)>
+        {
+            return pitched_unique_ptr<T, decltype(&std::free)>{detail::pitched_new<T, RowAlignment>(x, y), &std::free};
+        }
+
+        template <class T, std::size_t RowAlignment = 64>
+        auto make_unique_pitched(std::size_t x, std::size_t y, std::size_t z) -> pitched_unique_ptr<T, decltype(&std::free)>
+        {
+            return pitched_unique_ptr<T, decltype(&std::free)>{detail::pitched_new<T, RowAlignment>(x, y * z), &std::free};
+        }
+    }
+}
+
+#endif /* GLADOS_GENERIC_PITCHED_ALLOCATOR_H_ */
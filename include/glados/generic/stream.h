@@ -0,0 +1,218 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_STREAM_H_
+#define GLADOS_GENERIC_STREAM_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <glados/generic/thread_pool.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        class event;
+
+        /*
+         * Host counterpart of a CUDA stream: work enqueued on a stream runs in order on a thread of
+         * the given pool, work of different streams runs concurrently. At most one pool thread
+         * serves a stream at a time and only while the stream has work. A stream waiting for an
+         * event occupies its thread, so the pool needs one thread per concurrently busy stream.
+         *
+         * An exception thrown by enqueued work doesn't stop the stream; the first one is rethrown
+         * by the next synchronize().
+         */
+        class stream
+        {
+            public:
+                explicit stream(thread_pool& pool) : pool_(pool) {}
+
+                stream(const stream&) = delete;
+                auto operator=(const stream&) -> stream& = delete;
+
+                ~stream()
+                {
+                    idle();
+                }
+
+                template <class F>
+                auto enqueue(F&& f) -> void
+                {
+                    auto start = false;
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        tasks_.emplace_back(std::forward<F>(f));
+                        start = !busy_;
+                        busy_ = true;
+                    }
+
+                    if(start)
+                        pool_.submit([this]() { drain(); });
+                }
+
+                // makes work enqueued from now on wait until e has completed
+                auto wait(const event& e) -> void;
+
+                // blocks until all enqueued work has run
+                auto synchronize() -> void
+                {
+                    idle();
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    if(error_ != nullptr)
+                    {
+                        auto e = error_;
+                        error_ = nullptr;
+                        std::rethrow_exception(e);
+                    }
+                }
+
+                // true if all enqueued work has run
+                auto query() -> bool
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    return !busy_;
+                }
+
+            private:
+                auto idle() -> void
+                {
+                    auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                    cv_.wait(lock, [this]() { return !busy_; });
+                }
+
+                auto drain() -> void
+                {
+                    while(true)
+                    {
+                        auto task = std::function<void()>{};
+                        {
+                            auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                            if(tasks_.empty())
+                            {
+                                busy_ = false;
+                                cv_.notify_all();
+                                return;
+                            }
+
+                            task = std::move(tasks_.front());
+                            tasks_.pop_front();
+                        }
+
+                        try
+                        {
+                            task();
+                        }
+                        catch(...)
+                        {
+                            auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                            if(error_ == nullptr)
+                                error_ = std::current_exception();
+                        }
+                    }
+                }
+
+            private:
+                thread_pool& pool_;
+                std::deque<std::function<void()>> tasks_;
+                std::mutex mutex_;
+                std::condition_variable cv_;
+                bool busy_ = false;
+                std::exception_ptr error_;
+        };
+
+        namespace detail
+        {
+            struct event_state
+            {
+                auto complete() -> void
+                {
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex};
+                        done = true;
+                    }
+                    cv.notify_all();
+                }
+
+                auto wait() -> void
+                {
+                    auto&& lock = std::unique_lock<std::mutex>{mutex};
+                    cv.wait(lock, [this]() { return done; });
+                }
+
+                std::mutex mutex;
+                std::condition_variable cv;
+                bool done = false;
+            };
+        }
+
+        /*
+         * Marks a point in a stream. An event which was never recorded counts as completed, a new
+         * record() doesn't affect waits on the previous one.
+         */
+        class event
+        {
+            public:
+                auto record(stream& s) -> void
+                {
+                    auto state = std::make_shared<detail::event_state>();
+                    s.enqueue([state]() { state->complete(); });
+                    state_ = std::move(state);
+                }
+
+                auto synchronize() const -> void
+                {
+                    if(state_ != nullptr)
+                        state_->wait();
+                }
+
+                auto query() const -> bool
+                {
+                    if(state_ == nullptr)
+                        return true;
+
+                    auto&& lock = std::lock_guard<std::mutex>{state_->mutex};
+                    return state_->done;
+                }
+
+            private:
+                friend class stream;
+                std::shared_ptr<detail::event_state> state_;
+        };
+
+        inline auto stream::wait(const event& e) -> void
+        {
+            auto state = e.state_;
+            if(state != nullptr)
+                enqueue([state]() { state->wait(); });
+        }
+    }
+}
+
+#endif /* GLADOS_GENERIC_STREAM_H_ */
@@ -0,0 +1,504 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_SYNC_POLICY_H_
+#define GLADOS_GENERIC_SYNC_POLICY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <glados/bits/memory_location.h>
+#include <glados/generic/stream.h>
+#include <glados/generic/thread_pool.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        namespace detail
+        {
+            // below these sizes a copy stays on the calling thread and in the cache, respectively
+            constexpr auto parallel_threshold = std::size_t{4} << 20;
+            constexpr auto streaming_threshold = std::size_t{16} << 20;
+
+            // from here on memcpy switches to a non-temporal loop of its own, which is faster than ours
+            constexpr auto libc_streaming_threshold = std::size_t{128} << 20;
+
+            // 1D and dense copies are cut into pieces of this size for the threads
+            constexpr auto piece_size = std::size_t{256} << 10;
+
+            template <class P, class = void>
+            struct is_pitched : std::false_type {};
+
+            template <class P>
+            struct is_pitched<P, typename std::enable_if<P::pitched_memory>::type> : std::true_type {};
+
+            template <class P, class = void>
+            struct is_host : std::true_type {}; // plain smart pointers don't tell
+
+            template <class P>
+            struct is_host<P, typename std::enable_if<P::mem_location != memory_location::host>::type> : std::false_type {};
+
+            template <class P>
+            auto pitch_of(const P& p, std::size_t) noexcept -> typename std::enable_if<is_pitched<P>::value, std::size_t>::type
+            {
+                return p.pitch();
+            }
+
+            template <class P>
+            auto pitch_of(const P&, std::size_t row_bytes) noexcept -> typename std::enable_if<!is_pitched<P>::value, std::size_t>::type
+            {
+                return row_bytes;
+            }
+
+            template <class P>
+            auto bytes_of(const P& p) noexcept -> unsigned char*
+            {
+                return reinterpret_cast<unsigned char*>(p.get());
+            }
+
+            // what an asynchronous operation keeps of a pointer: the memory, not the owner
+            template <class T, bool Pitched>
+            struct host_view
+            {
+                using element_type = T;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto pitched_memory = Pitched;
+
+                auto get() const noexcept -> T* { return ptr; }
+                auto pitch() const noexcept -> std::size_t { return pitch_bytes; }
+
+                T* ptr;
+                std::size_t pitch_bytes;
+            };
+
+            template <class P>
+            auto view_of(const P& p) noexcept -> host_view<typename P::element_type, is_pitched<P>::value>
+            {
+                return host_view<typename P::element_type, is_pitched<P>::value>{p.get(), pitch_of(p, 0)};
+            }
+
+            // the stores bypass the cache, a large destination would only evict the working set
+            inline auto stream_copy(unsigned char* d, const unsigned char* s, std::size_t n) noexcept -> void
+            {
+#if defined(__SSE2__)
+                auto head = std::min((16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16, n);
+                std::memcpy(d, s, head);
+                d += head;
+                s += head;
+                n -= head;
+
+                for(; n >= 64; n -= 64, d += 64, s += 64)
+                {
+                    auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                    auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+                    auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+                    auto e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+                }
+#endif
+                std::memcpy(d, s, n);
+            }
+
+            inline auto stream_fence() noexcept -> void
+            {
+#if defined(__SSE2__)
+                _mm_sfence();
+#endif
+            }
+
+            // the pool of a sync_policy which wasn't given one, started by the first job large enough to need it
+            inline auto default_pool() -> thread_pool&
+            {
+                static thread_pool pool;
+                return pool;
+            }
+
+            /*
+             * Shared by the calling thread and the pool helpers of for_rows(). A helper which starts
+             * after all ranges have been taken leaves at once, so the caller only waits for the
+             * ranges, not for the helpers, and a copy issued from a pool thread can't deadlock.
+             */
+            template <class Func>
+            class row_job
+            {
+                public:
+                    row_job(Func f, std::size_t rows, std::size_t per_range) noexcept
+                    : f_(f), rows_{rows}, per_range_{per_range}, ranges_{(rows + per_range - 1) / per_range}
+                    {}
+
+                    auto work() -> void
+                    {
+                        while(true)
+                        {
+                            auto i = next_.fetch_add(1, std::memory_order_relaxed);
+                            if(i >= ranges_)
+                                return;
+
+                            auto first = i * per_range_;
+                            f_(first, std::min(first + per_range_, rows_));
+
+                            if(done_.fetch_add(1, std::memory_order_acq_rel) + 1 == ranges_)
+                            {
+                                auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                                cv_.notify_all();
+                            }
+                        }
+                    }
+
+                    auto wait() -> void
+                    {
+                        auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                        cv_.wait(lock, [this]() { return done_.load(std::memory_order_acquire) == ranges_; });
+                    }
+
+                private:
+                    Func f_;
+                    std::size_t rows_;
+                    std::size_t per_range_;
+                    std::size_t ranges_;
+                    std::atomic<std::size_t> next_{0};
+                    std::atomic<std::size_t> done_{0};
+                    std::mutex mutex_;
+                    std::condition_variable cv_;
+            };
+
+            /*
+             * Calls f(first, last) on ranges of the rows [0, rows). Large jobs are split into up to
+             * threads ranges, which the calling thread and the threads of pool work off together.
+             * f must not throw.
+             */
+            template <class Func>
+            auto for_rows(std::size_t rows, std::size_t row_bytes, std::size_t threads, thread_pool* pool, Func f) -> void
+            {
+                auto total = rows * row_bytes;
+                auto n = std::min({threads, rows, std::max(total / parallel_threshold, std::size_t{1})});
+                if(n <= 1)
+                {
+                    f(std::size_t{0}, rows);
+                    return;
+                }
+
+                auto&& workers = (pool != nullptr) ? *pool : default_pool();
+                auto job = std::make_shared<row_job<Func>>(f, rows, (rows + n - 1) / n);
+                auto helpers = std::min(n - 1, workers.size());
+                for(auto i = std::size_t{0}; i < helpers; ++i)
+                    workers.submit([job]() { job->work(); });
+
+                job->work();
+                job->wait();
+            }
+
+            inline auto copy_rows(unsigned char* d, std::size_t d_pitch, const unsigned char* s, std::size_t s_pitch,
+                                  std::size_t row_bytes, std::size_t rows, std::size_t threads, thread_pool* pool) -> void
+            {
+                auto stream = (rows * row_bytes >= streaming_threshold);
+                for_rows(rows, row_bytes, threads, pool, [=](std::size_t first, std::size_t last) {
+                    for(auto r = first; r < last; ++r)
+                    {
+                        if(stream)
+                            stream_copy(d + r * d_pitch, s + r * s_pitch, row_bytes);
+                        else
+                            std::memcpy(d + r * d_pitch, s + r * s_pitch, row_bytes);
+                    }
+                    if(stream)
+                        stream_fence();
+                });
+            }
+
+            inline auto copy_dense(unsigned char* d, const unsigned char* s, std::size_t bytes, std::size_t threads, thread_pool* pool) -> void
+            {
+                auto pieces = (bytes + piece_size - 1) / piece_size;
+                auto stream = (bytes >= streaming_threshold);
+                for_rows(pieces, piece_size, threads, pool, [=](std::size_t first, std::size_t last) {
+                    auto begin = first * piece_size;
+                    auto end = std::min(last * piece_size, bytes);
+                    if(stream && (end - begin < libc_streaming_threshold))
+                    {
+                        stream_copy(d + begin, s + begin, end - begin);
+                        stream_fence();
+                    }
+                    else
+                        std::memcpy(d + begin, s + begin, end - begin);
+                });
+            }
+
+            inline auto fill_rows(unsigned char* p, std::size_t pitch, int value, std::size_t row_bytes, std::size_t rows,
+                                  std::size_t threads, thread_pool* pool) -> void
+            {
+                if(pitch == row_bytes)
+                {
+                    auto bytes = rows * row_bytes;
+                    auto pieces = (bytes + piece_size - 1) / piece_size;
+                    for_rows(pieces, piece_size, threads, pool, [=](std::size_t first, std::size_t last) {
+                        auto begin = first * piece_size;
+                        std::memset(p + begin, value, std::min(last * piece_size, bytes) - begin);
+                    });
+                    return;
+                }
+
+                for_rows(rows, row_bytes, threads, pool, [=](std::size_t first, std::size_t last) {
+                    for(auto r = first; r < last; ++r)
+                        std::memset(p + r * pitch, value, row_bytes);
+                });
+            }
+        }
+
+        /*
+         * Host counterpart of cuda::sync_policy, so copy() and fill() from glados/cuda/algorithm.h
+         * also work without a GPU. Pitched pointers are honoured, the 3D offsets are interpreted
+         * like cudaMemcpy3D does. Copies and fills of several MiB are spread over the calling thread
+         * and the threads of a thread_pool, a process-wide one unless a pool is given. Copies
+         * larger than the last-level cache use non-temporal stores. Like cudaMemset, fill() sets
+         * every byte to value.
+         */
+        class sync_policy
+        {
+            public:
+                constexpr sync_policy() noexcept : threads_{0}, pool_{nullptr} {}
+
+                // at most threads threads take part in one copy, 0 means one per core
+                constexpr explicit sync_policy(std::size_t threads) noexcept : threads_{threads}, pool_{nullptr} {}
+
+                // the pool has to outlive the policy, threads 0 means the pool's threads and the caller
+                explicit sync_policy(thread_pool& pool, std::size_t threads = 0) noexcept : threads_{threads}, pool_{&pool} {}
+
+                template <class D, class S>
+                auto copy(D& d, const S& s, std::size_t x) const -> void
+                {
+                    static_assert(!detail::is_pitched<D>::value, "Destination memory must not be pitched for a 1D copy.");
+                    static_assert(!detail::is_pitched<S>::value, "Source memory must not be pitched for a 1D copy.");
+                    check<D, S>();
+
+                    constexpr auto size = sizeof(typename D::element_type);
+                    detail::copy_dense(detail::bytes_of(d), detail::bytes_of(s), x * size, threads(), pool_);
+                }
+
+                template <class D, class S>
+                auto copy(D& d, const S& s, std::size_t x, std::size_t y) const -> void
+                {
+                    check<D, S>();
+
+                    constexpr auto size = sizeof(typename D::element_type);
+                    auto row_bytes = x * size;
+                    auto d_pitch = detail::pitch_of(d, row_bytes);
+                    auto s_pitch = detail::pitch_of(s, row_bytes);
+
+                    if((d_pitch == row_bytes) && (s_pitch == row_bytes))
+                        detail::copy_dense(detail::bytes_of(d), detail::bytes_of(s), row_bytes * y, threads(), pool_);
+                    else
+                        detail::copy_rows(detail::bytes_of(d), d_pitch, detail::bytes_of(s), s_pitch, row_bytes, y, threads(), pool_);
+                }
+
+                template <class D, class S>
+                auto copy(D& d, const S& s, std::size_t x, std::size_t y, std::size_t z,
+                            std::size_t d_off_x = 0, std::size_t d_off_y = 0, std::size_t d_off_z = 0,
+                            std::size_t s_off_x = 0, std::size_t s_off_y = 0, std::size_t s_off_z = 0) const
+                -> void
+                {
+                    check<D, S>();
+
+                    constexpr auto size = sizeof(typename D::element_type);
+                    auto row_bytes = x * size;
+                    auto d_pitch = detail::pitch_of(d, row_bytes);
+                    auto s_pitch = detail::pitch_of(s, row_bytes);
+
+                    // as with cudaMemcpy3D, a slice of either side has y rows
+                    auto d_first = detail::bytes_of(d) + (d_off_z * y + d_off_y) * d_pitch + d_off_x * size;
+                    auto s_first = detail::bytes_of(s) + (s_off_z * y + s_off_y) * s_pitch + s_off_x * size;
+
+                    if((d_pitch == row_bytes) && (s_pitch == row_bytes))
+                        detail::copy_dense(d_first, s_first, row_bytes * y * z, threads(), pool_);
+                    else
+                        detail::copy_rows(d_first, d_pitch, s_first, s_pitch, row_bytes, y * z, threads(), pool_);
+                }
+
+                template <class P>
+                auto fill(P& p, int value, std::size_t x) const -> void
+                {
+                    static_assert(!detail::is_pitched<P>::value, "The memory must not be pitched for a 1D fill operation.");
+                    static_assert(detail::is_host<P>::value, "The memory must be located on the host.");
+
+                    constexpr auto size = sizeof(typename P::element_type);
+                    detail::fill_rows(detail::bytes_of(p), x * size, value, x * size, 1, threads(), pool_);
+                }
+
+                template <class P>
+                auto fill(P& p, int value, std::size_t x, std::size_t y) const -> void
+                {
+                    static_assert(detail::is_host<P>::value, "The memory must be located on the host.");
+
+                    constexpr auto size = sizeof(typename P::element_type);
+                    detail::fill_rows(detail::bytes_of(p), detail::pitch_of(p, x * size), value, x * size, y, threads(), pool_);
+                }
+
+                template <class P>
+                auto fill(P& p, int value, std::size_t x, std::size_t y, std::size_t z) const -> void
+                {
+                    static_assert(detail::is_host<P>::value, "The memory must be located on the host.");
+
+                    constexpr auto size = sizeof(typename P::element_type);
+                    detail::fill_rows(detail::bytes_of(p), detail::pitch_of(p, x * size), value, x * size, y * z, threads(), pool_);
+                }
+
+            private:
+                template <class D, class S>
+                static auto check() noexcept -> void
+                {
+                    static_assert(detail::is_host<D>::value, "Destination memory must be located on the host.");
+                    static_assert(detail::is_host<S>::value, "Source memory must be located on the host.");
+                    static_assert(sizeof(typename D::element_type) == sizeof(typename S::element_type), "Element sizes of source and destination differ.");
+                }
+
+                auto threads() const noexcept -> std::size_t
+                {
+                    if(threads_ != 0)
+                        return threads_;
+
+                    if(pool_ != nullptr)
+                        return pool_->size() + 1;
+
+                    static const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+                    return cores;
+                }
+
+            private:
+                std::size_t threads_;
+                thread_pool* pool_;
+        };
+
+        constexpr auto sync = sync_policy{};
+
+        /*
+         * Host counterpart of cuda::async_policy: the operations of sync_policy are enqueued on a
+         * generic::stream and return at once. As with CUDA, the memory has to stay alive until the
+         * stream has run the operation, the smart pointers themselves may go away. By default one
+         * thread carries out an operation so that copies don't compete with the computation they
+         * are meant to overlap.
+         */
+        class async_policy
+        {
+            public:
+                constexpr async_policy() noexcept : sync_{1} {}
+
+                constexpr explicit async_policy(std::size_t threads) noexcept : sync_{threads} {}
+
+                template <class D, class S>
+                auto copy(D& d, const S& s, stream& st, std::size_t x) const -> void
+                {
+                    check<D, S>();
+
+                    auto dv = detail::view_of(d);
+                    auto sv = detail::view_of(s);
+                    auto policy = sync_;
+                    st.enqueue([=]() mutable { policy.copy(dv, sv, x); });
+                }
+
+                template <class D, class S>
+                auto copy(D& d, const S& s, stream& st, std::size_t x, std::size_t y) const -> void
+                {
+                    check<D, S>();
+
+                    auto dv = detail::view_of(d);
+                    auto sv = detail::view_of(s);
+                    auto policy = sync_;
+                    st.enqueue([=]() mutable { policy.copy(dv, sv, x, y); });
+                }
+
+                template <class D, class S>
+                auto copy(D& d, const S& s, stream& st, std::size_t x, std::size_t y, std::size_t z,
+                            std::size_t d_off_x = 0, std::size_t d_off_y = 0, std::size_t d_off_z = 0,
+                            std::size_t s_off_x = 0, std::size_t s_off_y = 0, std::size_t s_off_z = 0) const
+                -> void
+                {
+                    check<D, S>();
+
+                    auto dv = detail::view_of(d);
+                    auto sv = detail::view_of(s);
+                    auto policy = sync_;
+                    st.enqueue([=]() mutable {
+                        policy.copy(dv, sv, x, y, z, d_off_x, d_off_y, d_off_z, s_off_x, s_off_y, s_off_z);
+                    });
+                }
+
+                template <class P>
+                auto fill(P& p, int value, stream& st, std::size_t x) const -> void
+                {
+                    static_assert(detail::is_host<P>::value, "The memory must be located on the host.");
+
+                    auto pv = detail::view_of(p);
+                    auto policy = sync_;
+                    st.enqueue([=]() mutable { policy.fill(pv, value, x); });
+                }
+
+                template <class P>
+                auto fill(P& p, int value, stream& st, std::size_t x, std::size_t y) const -> void
+                {
+                    static_assert(detail::is_host<P>::value, "The memory must be located on the host.");
+
+                    auto pv = detail::view_of(p);
+                    auto policy = sync_;
+                    st.enqueue([=]() mutable { policy.fill(pv, value, x, y); });
+                }
+
+                template <class P>
+                auto fill(P& p, int value, stream& st, std::size_t x, std::size_t y, std::size_t z) const -> void
+                {
+                    static_assert(detail::is_host<P>::value, "The memory must be located on the host.");
+
+                    auto pv = detail::view_of(p);
+                    auto policy = sync_;
+                    st.enqueue([=]() mutable { policy.fill(pv, value, x, y, z); });
+                }
+
+            private:
+                template <class D, class S>
+                static auto check() noexcept -> void
+                {
+                    static_assert(detail::is_host<D>::value, "Destination memory must be located on the host.");
+                    static_assert(detail::is_host<S>::value, "Source memory must be located on the host.");
+                }
+
+            private:
+                sync_policy sync_;
+        };
+
+        constexpr auto async = async_policy{};
+    }
+}
+
+#endif /* GLADOS_GENERIC_SYNC_POLICY_H_ */
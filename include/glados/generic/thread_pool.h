@@ -0,0 +1,196 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_GENERIC_THREAD_POOL_H_
+#define GLADOS_GENERIC_THREAD_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * A fixed set of worker threads executing submitted callables in FIFO order. The threads are
+         * started once on construction and joined on destruction after the remaining tasks have been
+         * executed. Pinning binds the i-th worker to the i-th given core (Linux only, ignored
+         * elsewhere).
+         *
+         * Tasks may block for a long time, e.g. pipeline stages waiting for input. Such tasks occupy
+         * their worker until they return, so the pool needs at least as many threads as there are
+         * concurrently running blocking tasks.
+         */
+        class thread_pool
+        {
+            public:
+                using size_type = std::size_t;
+
+            public:
+                thread_pool() : thread_pool(default_size()) {}
+
+                explicit thread_pool(size_type threads)
+                {
+                    start(std::vector<int>(std::max(threads, size_type{1}), -1));
+                }
+
+                /* Starts one pinned worker per entry of cores */
+                explicit thread_pool(const std::vector<int>& cores)
+                {
+                    if(cores.empty())
+                        throw std::invalid_argument{"glados::generic::thread_pool: empty core list"};
+
+                    start(cores);
+                }
+
+                thread_pool(const thread_pool&) = delete;
+                auto operator=(const thread_pool&) -> thread_pool& = delete;
+
+                ~thread_pool()
+                {
+                    shutdown();
+                }
+
+                template <class F>
+                auto submit(F&& f) -> std::future<typename std::result_of<F()>::type>
+                {
+                    using result_type = typename std::result_of<F()>::type;
+
+                    // std::function needs a copyable target
+                    auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(f));
+                    auto ret = task->get_future();
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        tasks_.emplace_back([task]() { (*task)(); });
+                    }
+                    cv_.notify_one();
+                    return ret;
+                }
+
+                auto size() const noexcept -> size_type
+                {
+                    return workers_.size();
+                }
+
+                static auto default_size() noexcept -> size_type
+                {
+                    auto n = std::thread::hardware_concurrency();
+                    return (n == 0) ? size_type{1} : size_type{n};
+                }
+
+            private:
+                auto start(const std::vector<int>& cores) -> void
+                {
+                    try
+                    {
+                        for(auto&& core : cores)
+                        {
+                            workers_.emplace_back(&thread_pool::work, this);
+                            if(core >= 0)
+                                pin(workers_.back(), core);
+                        }
+                    }
+                    catch(...)
+                    {
+                        shutdown();
+                        throw;
+                    }
+                }
+
+                auto shutdown() noexcept -> void
+                {
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        stop_ = true;
+                    }
+                    cv_.notify_all();
+
+                    for(auto&& w : workers_)
+                    {
+                        if(w.joinable())
+                            w.join();
+                    }
+                }
+
+                auto work() -> void
+                {
+                    while(true)
+                    {
+                        auto task = std::function<void()>{};
+                        {
+                            auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                            cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                            if(tasks_.empty())
+                                return;
+
+                            task = std::move(tasks_.front());
+                            tasks_.pop_front();
+                        }
+
+                        // exceptions are stored in the task's future
+                        task();
+                    }
+                }
+
+                static auto pin(std::thread& t, int core) -> void
+                {
+#if defined(__linux__)
+                    auto set = cpu_set_t{};
+                    CPU_ZERO(&set);
+                    CPU_SET(static_cast<std::size_t>(core), &set);
+                    auto err = pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &set);
+                    if(err != 0)
+                        throw std::system_error{err, std::system_category(), "glados::generic::thread_pool: pinning failed"};
+#else
+                    static_cast<void>(t);
+                    static_cast<void>(core);
+#endif
+                }
+
+            private:
+                std::vector<std::thread> workers_;
+                std::deque<std::function<void()>> tasks_;
+                std::mutex mutex_;
+                std::condition_variable cv_;
+                bool stop_ = false;
+        };
+    }
+}
+
+#endif /* GLADOS_GENERIC_THREAD_POOL_H_ */
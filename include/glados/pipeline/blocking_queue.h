@@ -0,0 +1,217 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_BLOCKING_QUEUE_H_
+#define GLADOS_PIPELINE_BLOCKING_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+#include <glados/pipeline/end_of_stream.h>
+#include <glados/pipeline/wait_policy.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Mutex-protected queue. Any number of threads may push and pop concurrently. A limit of 0
+         * means that the queue is unbounded.
+         *
+         * close() ends the stream of elements pushed so far: once they have been popped, pop() throws
+         * end_of_stream until reopen() moves on to the elements pushed after close(). cancel() makes
+         * push() throw end_of_stream and pop() throw once the queue is empty.
+         */
+        template <class T>
+        class blocking_queue
+        {
+            private:
+                using mutex_type = std::mutex;
+                using write_lock = std::unique_lock<mutex_type>;
+
+            public:
+                using queue_type = std::queue<T>;
+                using size_type = typename queue_type::size_type;
+
+                static constexpr auto multi_producer = true;
+                static constexpr auto multi_consumer = true;
+
+            public:
+                blocking_queue() : blocking_queue(0) {}
+                blocking_queue(size_type limit, wait_policy policy = spin_then_park)
+                : queue_{}, limit_{limit}, policy_{policy}, size_{0}, pushed_{0}, popped_{0}, cancelled_{false}
+                {}
+
+                blocking_queue(const blocking_queue& other) = delete;
+                auto operator=(const blocking_queue& other) -> blocking_queue& = delete;
+
+                blocking_queue(blocking_queue&& other)
+                {
+                    auto&& lock = write_lock{other.mutex_};
+                    queue_ = std::move(other.queue_);
+                    limit_ = std::move(other.limit_);
+                    policy_ = other.policy_;
+                    size_.store(queue_.size());
+                    pushed_ = other.pushed_;
+                    popped_ = other.popped_;
+                    ends_ = std::move(other.ends_);
+                    cancelled_.store(other.cancelled_.load());
+                    other.size_.store(0);
+                }
+
+                auto operator=(blocking_queue&& other) -> blocking_queue&
+                {
+                    if(this != &other)
+                    {
+                        // prevent possible deadlock
+                        auto&& this_lock = write_lock{mutex_, std::defer_lock};
+                        auto&& other_lock = write_lock{other.mutex_, std::defer_lock};
+                        std::lock(this_lock, other_lock);
+                        queue_ = std::move(other.queue_);
+                        limit_ = std::move(other.limit_);
+                        policy_ = other.policy_;
+                        size_.store(queue_.size());
+                        pushed_ = other.pushed_;
+                        popped_ = other.popped_;
+                        ends_ = std::move(other.ends_);
+                        cancelled_.store(other.cancelled_.load());
+                        other.size_.store(0);
+                    }
+
+                    return *this;
+                }
+
+                auto push(T&& t) -> void
+                {
+                    auto&& lock = write_lock{mutex_, std::defer_lock};
+                    if(limit_ != 0)
+                        detail::wait(policy_, lock, not_full_, [this]() { return (size_.load(std::memory_order_acquire) < limit_) || cancelled_.load(std::memory_order_acquire); });
+                    else
+                        lock.lock();
+
+                    if(cancelled_.load(std::memory_order_relaxed))
+                        throw end_of_stream{};
+
+                    queue_.push(std::move(t));
+                    ++pushed_;
+                    size_.store(queue_.size(), std::memory_order_release);
+
+                    lock.unlock();
+                    not_empty_.notify_one();
+                }
+
+                auto pop() -> T
+                {
+                    auto&& lock = write_lock{mutex_, std::defer_lock};
+                    detail::wait(policy_, lock, not_empty_, [this]() {
+                        return (size_.load(std::memory_order_acquire) != 0) || ends_.closed() || cancelled_.load(std::memory_order_acquire);
+                    });
+
+                    if(queue_.empty() || ends_.reached(popped_))
+                        throw end_of_stream{};
+
+                    auto ret = std::move(queue_.front());
+                    queue_.pop();
+                    ++popped_;
+                    size_.store(queue_.size(), std::memory_order_release);
+
+                    lock.unlock();
+                    if(limit_ != 0)
+                        not_full_.notify_one();
+
+                    return ret;
+                }
+
+                auto close() -> void
+                {
+                    {
+                        auto&& lock = write_lock{mutex_};
+                        ends_.close(pushed_);
+                    }
+                    not_empty_.notify_all();
+                }
+
+                /* Called by the consumer after it received end_of_stream */
+                auto reopen() -> void
+                {
+                    ends_.reopen();
+                }
+
+                /* Releases all waiting threads */
+                auto cancel() -> void
+                {
+                    {
+                        auto&& lock = write_lock{mutex_};
+                        cancelled_.store(true, std::memory_order_release);
+                    }
+                    not_empty_.notify_all();
+                    not_full_.notify_all();
+                }
+
+                /* Drops all elements and undoes close() and cancel(). Must not be called while the queue is in use */
+                auto reset() -> void
+                {
+                    auto&& lock = write_lock{mutex_};
+                    queue_ = queue_type{};
+                    size_.store(0);
+                    pushed_ = 0;
+                    popped_ = 0;
+                    ends_.reset();
+                    cancelled_.store(false);
+                }
+
+                auto closed() const noexcept -> bool
+                {
+                    return ends_.closed();
+                }
+
+                auto set_wait_policy(wait_policy policy) noexcept -> void
+                {
+                    policy_ = policy;
+                }
+
+                auto size() const noexcept -> size_type
+                {
+                    return size_.load(std::memory_order_acquire);
+                }
+
+            private:
+                queue_type queue_;
+                size_type limit_;
+                wait_policy policy_;
+                std::atomic<size_type> size_;
+                size_type pushed_;
+                size_type popped_;
+                detail::stream_ends ends_;
+                std::atomic<bool> cancelled_;
+                mutable mutex_type mutex_;
+                std::condition_variable not_empty_;
+                std::condition_variable not_full_;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_BLOCKING_QUEUE_H_ */
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_END_OF_STREAM_H_
+#define GLADOS_PIPELINE_END_OF_STREAM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Thrown by a queue when popping past the end of a stream or when pushing into a cancelled
+         * queue. stage::run treats it as the regular end of a stage, so stage implementations usually
+         * just let it pass. Stages which have to flush state at the end of the stream may catch it.
+         */
+        class end_of_stream : public std::exception
+        {
+            public:
+                end_of_stream() noexcept = default;
+                virtual ~end_of_stream() = default;
+
+                virtual auto what() const noexcept -> const char*
+                {
+                    return "end of stream";
+                }
+        };
+
+        namespace detail
+        {
+            /*
+             * The ends of the streams passing through a queue, given as the number of elements pushed
+             * since the last reset. A producer may already push the next stream while the consumer is
+             * still busy with the current one, so further ends are kept until the consumer reopens
+             * the queue. Only the current end is read on the hot path.
+             */
+            class stream_ends
+            {
+                public:
+                    using size_type = std::size_t;
+
+                    static constexpr auto none = std::numeric_limits<size_type>::max();
+
+                public:
+                    stream_ends() noexcept = default;
+
+                    /* Moving is only allowed while the owning queue is not in use */
+                    stream_ends(stream_ends&& other) noexcept
+                    : current_{other.current_.load()}, pending_{std::move(other.pending_)}
+                    {}
+
+                    auto operator=(stream_ends&& other) noexcept -> stream_ends&
+                    {
+                        current_.store(other.current_.load());
+                        pending_ = std::move(other.pending_);
+                        return *this;
+                    }
+
+                    auto close(size_type pos) -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        if(current_.load(std::memory_order_relaxed) == none)
+                            current_.store(pos, std::memory_order_release);
+                        else
+                            pending_.push_back(pos);
+                    }
+
+                    /* Moves on to the next stream, called by the consumer after it reached the end */
+                    auto reopen() -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        if(pending_.empty())
+                            current_.store(none, std::memory_order_release);
+                        else
+                        {
+                            current_.store(pending_.front(), std::memory_order_release);
+                            pending_.pop_front();
+                        }
+                    }
+
+                    auto reset() -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        current_.store(none);
+                        pending_.clear();
+                    }
+
+                    auto reached(size_type pos) const noexcept -> bool
+                    {
+                        return pos == current_.load(std::memory_order_acquire);
+                    }
+
+                    auto closed() const noexcept -> bool
+                    {
+                        return current_.load(std::memory_order_acquire) != none;
+                    }
+
+                private:
+                    std::atomic<size_type> current_{none};
+                    std::deque<size_type> pending_;
+                    std::mutex mutex_;
+            };
+        }
+    }
+}
+
+#endif /* GLADOS_PIPELINE_END_OF_STREAM_H_ */
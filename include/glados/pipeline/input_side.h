@@ -23,92 +23,190 @@
 #ifndef GLADOS_PIPELINE_INPUT_SIDE_H_
 #define GLADOS_PIPELINE_INPUT_SIDE_H_
 
+#include <atomic>
 #include <cstddef>
-#include <mutex>
-#include <queue>
-#include <thread>
 #include <type_traits>
 #include <utility>
 
+#include <glados/pipeline/blocking_queue.h>
+#include <glados/pipeline/end_of_stream.h>
+#include <glados/pipeline/metrics.h>
+#include <glados/pipeline/wait_policy.h>
+
 namespace glados
 {
     namespace pipeline
     {
-        template <class InputT>
-        class input_side
+        namespace detail
         {
-            private:
-                using mutex_type = std::mutex;
-                using write_lock = std::unique_lock<mutex_type>;
+            /*
+             * The part of an input_side an output_side talks to. This hides the queue type so that
+             * stages with different queues can be connected. The port counts the output_sides
+             * attached to it and closes its input once all of them have finished.
+             */
+            template <class InputT>
+            class input_port
+            {
+                public:
+                    input_port() noexcept = default;
+
+                    input_port(input_port&& other) noexcept
+                    : producers_{other.producers_}, open_producers_{other.open_producers_.load()}
+                    {}
+
+                    auto operator=(input_port&& other) noexcept -> input_port&
+                    {
+                        producers_ = other.producers_;
+                        open_producers_.store(other.open_producers_.load());
+                        return *this;
+                    }
+
+                    virtual ~input_port() = default;
+                    virtual auto push(InputT&& t) -> void = 0;
+                    virtual auto size() const noexcept -> std::size_t = 0;
+                    virtual auto close_input() -> void = 0;
+
+                    auto attach_producer() noexcept -> void
+                    {
+                        ++producers_;
+                        open_producers_.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    auto detach_producer() noexcept -> void
+                    {
+                        --producers_;
+                        open_producers_.fetch_sub(1, std::memory_order_relaxed);
+                    }
+
+                    auto producer_finished() -> void
+                    {
+                        auto open = open_producers_.load(std::memory_order_relaxed);
+                        while(open > 1)
+                        {
+                            if(open_producers_.compare_exchange_weak(open, open - 1, std::memory_order_acq_rel))
+                                return;
+                        }
+
+                        open_producers_.store(0, std::memory_order_relaxed);
+                        close_input();
+                    }
+
+                    auto producers() const noexcept -> std::size_t
+                    {
+                        return producers_;
+                    }
+
+                protected:
+                    auto reopen_producers() noexcept -> void
+                    {
+                        open_producers_.store(producers_);
+                    }
 
+                private:
+                    std::size_t producers_ = 0;
+                    std::atomic<std::size_t> open_producers_{0};
+            };
+
+            template <>
+            class input_port<void>
+            {
+            };
+        }
+
+        template <class InputT, class QueueT = blocking_queue<InputT>>
+        class input_side : public detail::input_port<InputT>
+                         , private detail::input_recorder
+        {
             public:
-                using queue_type = std::queue<InputT>;
+                using queue_type = QueueT;
                 using size_type = typename queue_type::size_type;
 
+                using detail::input_recorder::collect_input_metrics;
+                using detail::input_recorder::reset_input_metrics;
+
             public:
-                input_side() : queue_{}, limit_{0} {};
-                input_side(size_type limit) : queue_{}, limit_{limit} {}
-                
+                input_side() : queue_{} {};
+                input_side(size_type limit) : queue_{limit} {}
+                input_side(size_type limit, wait_policy policy) : queue_{limit, policy} {}
+
                 input_side(const input_side& other) = delete;
                 auto operator=(const input_side& other) -> input_side& = delete;
 
-                input_side(input_side&& other)
+                input_side(input_side&& other) = default;
+                auto operator=(input_side&& other) -> input_side& = default;
+
+                template <class T>
+                auto input(T&& t) -> typename std::enable_if<std::is_same<InputT, T>::value, void>::type
                 {
-                    auto&& lock = write_lock{other.mutex_};
-                    queue_ = std::move(other.queue_);
-                    limit_ = std::move(other.limit_);
+                    queue_.push(std::forward<T>(t));
+                    this->record_depth(queue_);
                 }
 
-                auto operator=(input_side&& other) -> input_side&
+                /* Throws end_of_stream at the end of the current stream */
+                auto take() -> InputT
                 {
-                    if(this != &other)
-                    {
-                        // prevent possible deadlock
-                        auto&& this_lock = write_lock{mutex_, std::defer_lock};
-                        auto&& other_lock = write_lock{other.mutex_, std::defer_lock};
-                        std::lock(this_lock, other_lock);
-                        queue_ = std::move(other.queue_);
-                        limit_ = std::move(other.limit_);
-                    }
+                    auto watch = detail::stopwatch{};
+                    auto ret = queue_.pop();
+                    this->record_take(watch);
+                    return ret;
+                }
 
-                    return *this;
+                auto push(InputT&& t) -> void override
+                {
+                    queue_.push(std::move(t));
+                    this->record_depth(queue_);
                 }
 
-                template <class T>
-                auto input(T&& t) -> typename std::enable_if<std::is_same<InputT, T>::value, void>::type
+                /* Ends the stream after the elements pushed so far */
+                auto close_input() -> void override
                 {
-                    if(limit_ != 0)
-                    {
-                        while(queue_.size() >= limit_)
-                            std::this_thread::yield();
-                    }
+                    queue_.close();
+                }
 
-                    auto&& lock = write_lock{mutex_};
-                    queue_.push(std::forward<T>(t));
+                /* Rejects further elements, called when the consumer stops early */
+                auto cancel_input() -> void
+                {
+                    queue_.cancel();
                 }
 
-                auto take() -> InputT
+                /* Moves on to the next stream once the current one has ended, keeping queued elements */
+                auto reopen_input() -> void
                 {
-                    while(queue_.empty())
-                        std::this_thread::yield();
+                    queue_.reopen();
+                    this->reopen_producers();
+                }
 
-                    auto&& lock = write_lock{mutex_};
+                /* Drops all elements for another run. Must not be called while the owning stage is running */
+                auto reset_input() -> void
+                {
+                    queue_.reset();
+                    this->reopen_producers();
+                }
 
-                    auto ret = std::move(queue_.front());
-                    queue_.pop();
+                /* Must not be called while the owning stage is running */
+                auto set_wait_policy(wait_policy policy) noexcept -> void
+                {
+                    queue_.set_wait_policy(policy);
+                }
 
-                    return ret;
+                auto size() const noexcept -> std::size_t override
+                {
+                    return queue_.size();
                 }
 
             private:
                 queue_type queue_;
-                size_type limit_;
-                mutable mutex_type mutex_;
         };
 
-        template <>
-        class input_side<void>
+        template <class QueueT>
+        class input_side<void, QueueT> : public detail::input_port<void>
         {
+            public:
+                auto cancel_input() noexcept -> void {}
+                auto reopen_input() noexcept -> void {}
+                auto reset_input() noexcept -> void {}
+                auto collect_input_metrics(stage_metrics&) const noexcept -> void {}
+                auto reset_input_metrics() noexcept -> void {}
         };
     }
 }
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_LAUNCH_H_
+#define GLADOS_PIPELINE_LAUNCH_H_
+
+#include <future>
+#include <utility>
+
+#include <glados/generic/thread_pool.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        namespace detail
+        {
+            // starts a new thread per call if no pool is given
+            template <class F>
+            auto launch(generic::thread_pool* pool, F&& f) -> std::future<void>
+            {
+                if(pool != nullptr)
+                    return pool->submit(std::forward<F>(f));
+
+                return std::async(std::launch::async, std::forward<F>(f));
+            }
+        }
+    }
+}
+
+#endif /* GLADOS_PIPELINE_LAUNCH_H_ */
@@ -0,0 +1,314 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_METRICS_H_
+#define GLADOS_PIPELINE_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Define GLADOS_PIPELINE_METRICS before including the pipeline headers to let every stage
+         * record its throughput and wait times. Without it the recorders are empty and all recording
+         * calls compile to nothing, metrics() then always returns zeros.
+         */
+#ifdef GLADOS_PIPELINE_METRICS
+        constexpr auto metrics_enabled = true;
+#else
+        constexpr auto metrics_enabled = false;
+#endif
+
+        struct stage_metrics
+        {
+            std::uint64_t items_in = 0;
+            std::uint64_t items_out = 0;
+            std::chrono::nanoseconds run_time{0};     // spent in StageT::run
+            std::chrono::nanoseconds input_wait{0};   // spent in take()
+            std::chrono::nanoseconds output_wait{0};  // spent handing results to the next stage (backpressure)
+            std::size_t queue_high_water = 0;         // of the input queue
+
+            auto busy_time() const noexcept -> std::chrono::nanoseconds
+            {
+                return run_time - input_wait - output_wait;
+            }
+        };
+
+        namespace detail
+        {
+            using metrics_clock = std::chrono::steady_clock;
+
+#ifdef GLADOS_PIPELINE_METRICS
+            // the counters are written by the stage's thread and read by anyone taking a snapshot
+            class counter
+            {
+                public:
+                    counter() noexcept = default;
+                    counter(counter&& other) noexcept : value_{other.value_.load()} {}
+
+                    auto operator=(counter&& other) noexcept -> counter&
+                    {
+                        value_.store(other.value_.load());
+                        return *this;
+                    }
+
+                    auto add(std::uint64_t n) noexcept -> void
+                    {
+                        value_.fetch_add(n, std::memory_order_relaxed);
+                    }
+
+                    auto raise_to(std::uint64_t n) noexcept -> void
+                    {
+                        auto cur = value_.load(std::memory_order_relaxed);
+                        while((n > cur) && !value_.compare_exchange_weak(cur, n, std::memory_order_relaxed)) {}
+                    }
+
+                    auto get() const noexcept -> std::uint64_t
+                    {
+                        return value_.load(std::memory_order_relaxed);
+                    }
+
+                    auto reset() noexcept -> void
+                    {
+                        value_.store(0, std::memory_order_relaxed);
+                    }
+
+                private:
+                    std::atomic<std::uint64_t> value_{0};
+            };
+
+            class stopwatch
+            {
+                public:
+                    stopwatch() noexcept : start_{metrics_clock::now()} {}
+
+                    auto elapsed_ns() const noexcept -> std::uint64_t
+                    {
+                        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(metrics_clock::now() - start_).count());
+                    }
+
+                private:
+                    metrics_clock::time_point start_;
+            };
+
+            class input_recorder
+            {
+                protected:
+                    auto record_take(const stopwatch& w) noexcept -> void
+                    {
+                        items_.add(1);
+                        wait_.add(w.elapsed_ns());
+                    }
+
+                    template <class QueueT>
+                    auto record_depth(const QueueT& q) noexcept -> void
+                    {
+                        high_water_.raise_to(q.size());
+                    }
+
+                    auto collect_input_metrics(stage_metrics& m) const noexcept -> void
+                    {
+                        m.items_in = items_.get();
+                        m.input_wait = std::chrono::nanoseconds{static_cast<std::int64_t>(wait_.get())};
+                        m.queue_high_water = static_cast<std::size_t>(high_water_.get());
+                    }
+
+                    auto reset_input_metrics() noexcept -> void
+                    {
+                        items_.reset();
+                        wait_.reset();
+                        high_water_.reset();
+                    }
+
+                private:
+                    counter items_;
+                    counter wait_;
+                    counter high_water_;
+            };
+
+            class output_recorder
+            {
+                protected:
+                    auto record_output(const stopwatch& w) noexcept -> void
+                    {
+                        items_.add(1);
+                        wait_.add(w.elapsed_ns());
+                    }
+
+                    auto collect_output_metrics(stage_metrics& m) const noexcept -> void
+                    {
+                        m.items_out = items_.get();
+                        m.output_wait = std::chrono::nanoseconds{static_cast<std::int64_t>(wait_.get())};
+                    }
+
+                    auto reset_output_metrics() noexcept -> void
+                    {
+                        items_.reset();
+                        wait_.reset();
+                    }
+
+                private:
+                    counter items_;
+                    counter wait_;
+            };
+
+            class run_recorder
+            {
+                protected:
+                    auto record_run(const stopwatch& w) noexcept -> void
+                    {
+                        time_.add(w.elapsed_ns());
+                    }
+
+                    auto collect_run_metrics(stage_metrics& m) const noexcept -> void
+                    {
+                        m.run_time = std::chrono::nanoseconds{static_cast<std::int64_t>(time_.get())};
+                    }
+
+                    auto reset_run_metrics() noexcept -> void
+                    {
+                        time_.reset();
+                    }
+
+                private:
+                    counter time_;
+            };
+#else
+            class stopwatch
+            {
+            };
+
+            class input_recorder
+            {
+                protected:
+                    auto record_take(const stopwatch&) noexcept -> void {}
+                    template <class QueueT>
+                    auto record_depth(const QueueT&) noexcept -> void {}
+                    auto collect_input_metrics(stage_metrics&) const noexcept -> void {}
+                    auto reset_input_metrics() noexcept -> void {}
+            };
+
+            class output_recorder
+            {
+                protected:
+                    auto record_output(const stopwatch&) noexcept -> void {}
+                    auto collect_output_metrics(stage_metrics&) const noexcept -> void {}
+                    auto reset_output_metrics() noexcept -> void {}
+            };
+
+            class run_recorder
+            {
+                protected:
+                    auto record_run(const stopwatch&) noexcept -> void {}
+                    auto collect_run_metrics(stage_metrics&) const noexcept -> void {}
+                    auto reset_run_metrics() noexcept -> void {}
+            };
+#endif
+        }
+
+        /*
+         * Samples the metrics of the watched stages every period on a thread of its own and hands
+         * them to the callback. A last sample is taken when the monitor is stopped. The stages must
+         * outlive the monitor.
+         */
+        class metrics_monitor
+        {
+            public:
+                using sample = std::vector<std::pair<std::string, stage_metrics>>;
+                using callback = std::function<void(const sample&)>;
+
+            public:
+                metrics_monitor(std::chrono::milliseconds period, callback cb)
+                : period_{period}, callback_{std::move(cb)}
+                {}
+
+                metrics_monitor(const metrics_monitor&) = delete;
+                auto operator=(const metrics_monitor&) -> metrics_monitor& = delete;
+
+                ~metrics_monitor()
+                {
+                    stop();
+                }
+
+                template <class Stage>
+                auto watch(std::string name, const Stage& s) -> void
+                {
+                    sources_.emplace_back(std::move(name), [&s]() { return s.metrics(); });
+                }
+
+                auto snapshot() const -> sample
+                {
+                    auto ret = sample{};
+                    for(auto&& src : sources_)
+                        ret.emplace_back(src.first, src.second());
+                    return ret;
+                }
+
+                auto start() -> void
+                {
+                    stop_ = false;
+                    thread_ = std::thread{[this]() {
+                        auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                        while(!cv_.wait_for(lock, period_, [this]() { return stop_; }))
+                            callback_(snapshot());
+                    }};
+                }
+
+                auto stop() -> void
+                {
+                    if(!thread_.joinable())
+                        return;
+
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        stop_ = true;
+                    }
+                    cv_.notify_all();
+                    thread_.join();
+                    callback_(snapshot());
+                }
+
+            private:
+                std::chrono::milliseconds period_;
+                callback callback_;
+                std::vector<std::pair<std::string, std::function<stage_metrics()>>> sources_;
+                std::thread thread_;
+                std::mutex mutex_;
+                std::condition_variable cv_;
+                bool stop_ = false;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_METRICS_H_ */
@@ -0,0 +1,387 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_MPMC_QUEUE_H_
+#define GLADOS_PIPELINE_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <glados/pipeline/end_of_stream.h>
+#include <glados/pipeline/wait_policy.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Bounded lock-free channel for any number of producer and consumer threads. Every slot
+         * carries a sequence number which tells producers and consumers whether the slot is free or
+         * filled for the current lap, so pushing and popping only need a single CAS on the shared
+         * position (D. Vyukov's bounded MPMC queue). Like spsc_queue the slots are allocated once and
+         * a limit of 0 selects default_capacity. The limit is rounded up to the next power of two and
+         * pop() requires T to be default constructible. close(), reopen() and cancel() behave like
+         * their blocking_queue counterparts, the try_ functions throw end_of_stream where push() and
+         * pop() would.
+         */
+        template <class T>
+        class mpmc_queue
+        {
+            private:
+                using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+                enum class status
+                {
+                    success,
+                    empty,
+                    end
+                };
+
+                struct cell
+                {
+                    std::atomic<std::size_t> sequence;
+                    storage_type storage;
+                };
+
+            public:
+                using size_type = std::size_t;
+
+                static constexpr auto default_capacity = size_type{1024};
+                static constexpr auto multi_producer = true;
+                static constexpr auto multi_consumer = true;
+
+            public:
+                mpmc_queue() : mpmc_queue(0) {}
+                mpmc_queue(size_type limit, wait_policy policy = spin_then_park)
+                : mask_{round_up_pow2((limit == 0) ? default_capacity : limit) - 1}
+                , cells_{new cell[mask_ + 1]}
+                , policy_{policy}, cancelled_{false}
+                , enqueue_pos_{0}, dequeue_pos_{0}
+                , producers_waiting_{0}, consumers_waiting_{0}
+                {
+                    for(auto i = size_type{0}; i <= mask_; ++i)
+                        cells_[i].sequence.store(i, std::memory_order_relaxed);
+                }
+
+                mpmc_queue(const mpmc_queue& other) = delete;
+                auto operator=(const mpmc_queue& other) -> mpmc_queue& = delete;
+
+                /* Moving is only allowed while the queue is not in use */
+                mpmc_queue(mpmc_queue&& other) noexcept
+                : mask_{other.mask_}, cells_{std::move(other.cells_)}, policy_{other.policy_}
+                , ends_{std::move(other.ends_)}, cancelled_{other.cancelled_.load()}
+                , enqueue_pos_{other.enqueue_pos_.load()}, dequeue_pos_{other.dequeue_pos_.load()}
+                , producers_waiting_{0}, consumers_waiting_{0}
+                {
+                    other.enqueue_pos_.store(0);
+                    other.dequeue_pos_.store(0);
+                }
+
+                auto operator=(mpmc_queue&& other) noexcept -> mpmc_queue&
+                {
+                    if(this != &other)
+                    {
+                        destroy_elements();
+                        mask_ = other.mask_;
+                        cells_ = std::move(other.cells_);
+                        policy_ = other.policy_;
+                        ends_ = std::move(other.ends_);
+                        cancelled_.store(other.cancelled_.load());
+                        enqueue_pos_.store(other.enqueue_pos_.load());
+                        dequeue_pos_.store(other.dequeue_pos_.load());
+                        other.enqueue_pos_.store(0);
+                        other.dequeue_pos_.store(0);
+                    }
+
+                    return *this;
+                }
+
+                ~mpmc_queue()
+                {
+                    destroy_elements();
+                }
+
+                auto try_push(T&& t) -> bool
+                {
+                    if(cancelled_.load(std::memory_order_relaxed))
+                        throw end_of_stream{};
+
+                    if(!enqueue(std::move(t)))
+                        return false;
+
+                    wake(consumers_waiting_, not_empty_);
+                    return true;
+                }
+
+                auto try_pop(T& t) -> bool
+                {
+                    auto result = dequeue(t);
+                    if(result == status::empty)
+                    {
+                        if(!cancelled_.load(std::memory_order_acquire))
+                            return false;
+
+                        throw end_of_stream{};
+                    }
+
+                    if(result == status::end)
+                        throw end_of_stream{};
+
+                    wake(producers_waiting_, not_full_);
+                    return true;
+                }
+
+                auto push(T&& t) -> void
+                {
+                    if(cancelled_.load(std::memory_order_relaxed))
+                        throw end_of_stream{};
+
+                    auto pushed = false;
+                    wait_for(producers_waiting_, not_full_, [this, &t, &pushed]() {
+                        pushed = enqueue(std::move(t));
+                        return pushed || cancelled_.load(std::memory_order_acquire);
+                    });
+
+                    if(!pushed)
+                        throw end_of_stream{};
+
+                    wake(consumers_waiting_, not_empty_);
+                }
+
+                auto pop() -> T
+                {
+                    auto ret = T{};
+                    auto result = status::empty;
+                    wait_for(consumers_waiting_, not_empty_, [this, &ret, &result]() {
+                        result = dequeue(ret);
+                        return (result != status::empty) || cancelled_.load(std::memory_order_acquire);
+                    });
+
+                    if(result != status::success)
+                        throw end_of_stream{};
+
+                    wake(producers_waiting_, not_full_);
+                    return ret;
+                }
+
+                /* Called after all producers have finished */
+                auto close() -> void
+                {
+                    ends_.close(enqueue_pos_.load(std::memory_order_acquire));
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    not_empty_.notify_all();
+                }
+
+                /* Called after the consumers have received end_of_stream */
+                auto reopen() -> void
+                {
+                    ends_.reopen();
+                }
+
+                /* Releases all waiting threads */
+                auto cancel() -> void
+                {
+                    cancelled_.store(true, std::memory_order_release);
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    not_empty_.notify_all();
+                    not_full_.notify_all();
+                }
+
+                /* Drops all elements and undoes close() and cancel(). Must not be called while the queue is in use */
+                auto reset() -> void
+                {
+                    if(cells_ == nullptr)
+                        return;
+
+                    destroy_elements();
+                    for(auto i = size_type{0}; i <= mask_; ++i)
+                        cells_[i].sequence.store(i, std::memory_order_relaxed);
+                    enqueue_pos_.store(0);
+                    dequeue_pos_.store(0);
+                    ends_.reset();
+                    cancelled_.store(false);
+                }
+
+                auto closed() const noexcept -> bool
+                {
+                    return ends_.closed();
+                }
+
+                auto set_wait_policy(wait_policy policy) noexcept -> void
+                {
+                    policy_ = policy;
+                }
+
+                auto size() const noexcept -> size_type
+                {
+                    auto head = dequeue_pos_.load(std::memory_order_acquire);
+                    auto tail = enqueue_pos_.load(std::memory_order_acquire);
+                    return (tail > head) ? (tail - head) : size_type{0};
+                }
+
+            private:
+                static auto round_up_pow2(size_type n) noexcept -> size_type
+                {
+                    auto ret = size_type{1};
+                    while(ret < n)
+                        ret <<= 1;
+                    return ret;
+                }
+
+                auto enqueue(T&& t) -> bool
+                {
+                    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    auto c = static_cast<cell*>(nullptr);
+                    while(true)
+                    {
+                        c = &cells_[pos & mask_];
+                        auto seq = c->sequence.load(std::memory_order_acquire);
+                        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                        if(diff == 0)
+                        {
+                            if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else if(diff < 0)
+                            return false; // full
+                        else
+                            pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    }
+
+                    ::new(static_cast<void*>(&c->storage)) T(std::move(t));
+                    c->sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+
+                auto dequeue(T& t) -> status
+                {
+                    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    auto c = static_cast<cell*>(nullptr);
+                    while(true)
+                    {
+                        c = &cells_[pos & mask_];
+                        auto seq = c->sequence.load(std::memory_order_acquire);
+                        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                        if(diff == 0)
+                        {
+                            // checked after the element became visible, so an earlier close() is visible, too
+                            if(ends_.reached(pos))
+                                return status::end;
+
+                            if(dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else if(diff < 0)
+                            return ends_.reached(pos) ? status::end : status::empty;
+                        else
+                            pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    }
+
+                    auto elem = reinterpret_cast<T*>(&c->storage);
+                    t = std::move(*elem);
+                    elem->~T();
+                    c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return status::success;
+                }
+
+                // op must be safe to retry, it is called until it succeeds
+                template <class Operation>
+                auto wait_for(std::atomic<size_type>& waiting, std::condition_variable& cv, Operation op) -> void
+                {
+                    static const auto multi_core = std::thread::hardware_concurrency() > 1u;
+                    auto spins = multi_core ? policy_.spins : size_type{0};
+                    for(auto i = size_type{0}; i <= spins; ++i)
+                    {
+                        if(op())
+                            return;
+
+                        detail::cpu_relax();
+                    }
+
+                    if(!policy_.park)
+                    {
+                        while(!op())
+                            std::this_thread::yield();
+                        return;
+                    }
+
+                    auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                    waiting.fetch_add(1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    cv.wait(lock, op);
+                    waiting.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                auto wake(std::atomic<size_type>& waiting, std::condition_variable& cv) -> void
+                {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if(waiting.load(std::memory_order_relaxed) != 0)
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        cv.notify_one();
+                    }
+                }
+
+                auto destroy_elements() noexcept -> void
+                {
+                    if(cells_ == nullptr)
+                        return;
+
+                    for(auto i = dequeue_pos_.load(); i != enqueue_pos_.load(); ++i)
+                        reinterpret_cast<T*>(&cells_[i & mask_].storage)->~T();
+                }
+
+            private:
+                static constexpr auto cache_line = size_type{64};
+
+                size_type mask_;
+                std::unique_ptr<cell[]> cells_;
+                wait_policy policy_;
+                detail::stream_ends ends_;
+                std::atomic<bool> cancelled_;
+                char pad0_[cache_line];
+                std::atomic<size_type> enqueue_pos_;
+                char pad1_[cache_line];
+                std::atomic<size_type> dequeue_pos_;
+                char pad2_[cache_line];
+                std::atomic<size_type> producers_waiting_;
+                std::atomic<size_type> consumers_waiting_;
+                std::mutex mutex_;
+                std::condition_variable not_empty_;
+                std::condition_variable not_full_;
+        };
+
+        template <class T>
+        constexpr typename mpmc_queue<T>::size_type mpmc_queue<T>::default_capacity;
+    }
+}
+
+#endif /* GLADOS_PIPELINE_MPMC_QUEUE_H_ */
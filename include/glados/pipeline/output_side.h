@@ -23,42 +23,147 @@
 #ifndef GLADOS_PIPELINE_OUTPUT_SIDE_H_
 #define GLADOS_PIPELINE_OUTPUT_SIDE_H_
 
+#include <atomic>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <glados/pipeline/input_side.h>
+#include <glados/pipeline/metrics.h>
 
 namespace glados
 {
     namespace pipeline
     {
+        /*
+         * How an output_side attached to several input_sides (fan-out) picks the receiver of an element.
+         * least_loaded chooses the receiver with the fewest queued elements.
+         */
+        enum class distribution
+        {
+            round_robin,
+            least_loaded
+        };
+
         template <class OutputT>
-        class output_side
+        class output_side : private detail::output_recorder
         {
             public:
+                using detail::output_recorder::collect_output_metrics;
+                using detail::output_recorder::reset_output_metrics;
+
+            public:
+                output_side() noexcept = default;
+
+                output_side(output_side&& other)
+                : next_{other.next_}, targets_{std::move(other.targets_)}, distribution_{other.distribution_}
+                , turn_{other.turn_.load()}
+                {
+                    other.next_ = nullptr;
+                }
+
+                auto operator=(output_side&& other) -> output_side&
+                {
+                    next_ = other.next_;
+                    targets_ = std::move(other.targets_);
+                    distribution_ = other.distribution_;
+                    turn_.store(other.turn_.load());
+                    other.next_ = nullptr;
+                    return *this;
+                }
+
                 template <class T>
                 auto output(T&& t)
                 -> typename std::enable_if<std::is_same<T, OutputT>::value, void>::type
                 {
-                    if(next_ == nullptr)
-                        return;
-
-                    next_->input(std::forward<T>(t));
+                    auto watch = detail::stopwatch{};
+                    if(next_ != nullptr)
+                        next_->push(std::forward<T>(t));
+                    else if(!targets_.empty())
+                        select()->push(std::forward<T>(t));
+                    this->record_output(watch);
                 }
 
-                auto attach(input_side<OutputT>* next) noexcept
+                auto attach(detail::input_port<OutputT>* next) noexcept
                 -> void
                 {
+                    detach();
                     next_ = next;
+                    next_->attach_producer();
+                }
+
+                auto attach(std::vector<detail::input_port<OutputT>*> targets, distribution d)
+                -> void
+                {
+                    detach();
+                    targets_ = std::move(targets);
+                    distribution_ = d;
+                    for(auto&& t : targets_)
+                        t->attach_producer();
+                }
+
+                /* Signals end of stream to every attached input */
+                auto close_output() -> void
+                {
+                    if(next_ != nullptr)
+                        next_->producer_finished();
+
+                    for(auto&& t : targets_)
+                        t->producer_finished();
+                }
+
+            private:
+                auto detach() noexcept -> void
+                {
+                    if(next_ != nullptr)
+                        next_->detach_producer();
+
+                    for(auto&& t : targets_)
+                        t->detach_producer();
+
+                    next_ = nullptr;
+                    targets_.clear();
+                }
+
+                auto select() noexcept -> detail::input_port<OutputT>*
+                {
+                    // the turn counter is shared if several threads output through this side
+                    auto n = targets_.size();
+                    auto first = turn_.fetch_add(1, std::memory_order_relaxed) % n;
+                    if(distribution_ == distribution::round_robin)
+                        return targets_[first];
+
+                    // start at a rotating position so that ties are not always resolved the same way
+                    auto best = targets_[first];
+                    auto best_size = best->size();
+                    for(auto i = std::size_t{1}; (i < n) && (best_size != 0); ++i)
+                    {
+                        auto candidate = targets_[(first + i) % n];
+                        auto candidate_size = candidate->size();
+                        if(candidate_size < best_size)
+                        {
+                            best = candidate;
+                            best_size = candidate_size;
+                        }
+                    }
+                    return best;
                 }
 
             private:
-                input_side<OutputT>* next_;
+                detail::input_port<OutputT>* next_ = nullptr;
+                std::vector<detail::input_port<OutputT>*> targets_;
+                distribution distribution_ = distribution::round_robin;
+                std::atomic<std::size_t> turn_{0};
         };
 
         template <>
         class output_side<void>
         {
+            public:
+                auto close_output() noexcept -> void {}
+                auto collect_output_metrics(stage_metrics&) const noexcept -> void {}
+                auto reset_output_metrics() noexcept -> void {}
         };
     }
 }
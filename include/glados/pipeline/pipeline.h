@@ -23,16 +23,36 @@
 #ifndef GLADOS_PIPELINE_PIPELINE_H_
 #define GLADOS_PIPELINE_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
+#include <mutex>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <glados/generic/thread_pool.h>
+#include <glados/pipeline/blocking_queue.h>
+#include <glados/pipeline/end_of_stream.h>
 #include <glados/pipeline/input_side.h>
+#include <glados/pipeline/launch.h>
+#include <glados/pipeline/metrics.h>
+#include <glados/pipeline/mpmc_queue.h>
 #include <glados/pipeline/output_side.h>
+#include <glados/pipeline/replicated_stage.h>
+#include <glados/pipeline/spsc_queue.h>
 #include <glados/pipeline/stage.h>
+#include <glados/pipeline/stage_group.h>
 #include <glados/pipeline/task_queue.h>
+#include <glados/pipeline/trace.h>
+#include <glados/pipeline/wait_policy.h>
+#include <glados/pipeline/work_stealing_queue.h>
 
 namespace glados
 {
@@ -43,22 +63,48 @@ namespace glados
             public:
                 template <class Last>
                 auto connect(Last& l) const noexcept
-                -> typename std::enable_if<std::is_base_of<input_side<typename Last::input_type>, Last>::value, void>::type
+                -> typename std::enable_if<std::is_base_of<detail::input_port<typename Last::input_type>, Last>::value, void>::type
                 {}
 
                 template <class First, class Second>
                 auto connect(First& f, Second& s) const noexcept
                 -> typename std::enable_if<std::is_base_of<output_side<typename First::output_type>, First>::value &&
-                                           std::is_base_of<input_side<typename Second::input_type>, Second>::value, void>::type
+                                           std::is_base_of<detail::input_port<typename Second::input_type>, Second>::value, void>::type
                 {
                     f.attach(&s);
                 }
 
-                template <class First, class Second, class... Rest>
-                auto connect(First& f, Second& s, Rest&... rs) const noexcept -> void
+                /* fan-out */
+                template <class First, class... Stages>
+                auto connect(First& f, const stage_group<Stages...>& g) const
+                -> typename std::enable_if<std::is_base_of<output_side<typename First::output_type>, First>::value, void>::type
+                {
+                    static_assert(std::is_same<typename First::output_type, typename stage_group<Stages...>::input_type>::value,
+                                  "Output type of the producer does not match the input type of the group.");
+                    f.attach(g.inputs(), g.get_distribution());
+                }
+
+                /* fan-in */
+                template <class Second, class... Stages>
+                auto connect(const stage_group<Stages...>& g, Second& s) const
+                -> typename std::enable_if<std::is_base_of<detail::input_port<typename Second::input_type>, Second>::value, void>::type
+                {
+                    static_assert(std::is_same<typename stage_group<Stages...>::output_type, typename Second::input_type>::value,
+                                  "Output type of the group does not match the input type of the consumer.");
+                    static_assert(Second::queue_type::multi_producer, "The consumer's queue does not support multiple producers.");
+                    for(auto&& o : g.outputs())
+                        o->attach(&s);
+                }
+
+                template <class... Stages>
+                auto connect(const stage_group<Stages...>&) const noexcept -> void
+                {}
+
+                template <class First, class Second, class Third, class... Rest>
+                auto connect(First&& f, Second&& s, Third&& t, Rest&&... rs) const -> void
                 {
                     connect(f, s);
-                    connect(s, rs...);
+                    connect(s, t, rs...);
                 }
 
                 template <class StageT, class... Args>
@@ -66,16 +112,57 @@ namespace glados
                 {
                     return stage<StageT>{std::forward<Args>(args)...};
                 }
+
+                template <class StageT, template <class> class QueueT, class... Args>
+                auto make_stage(Args&&... args) const -> stage<StageT, QueueT>
+                {
+                    return stage<StageT, QueueT>{std::forward<Args>(args)...};
+                }
+
+                // the replicas run on the pipeline's thread_pool, if it has one
+                template <class StageT, class... Args>
+                auto make_replicated_stage(std::size_t replicas, std::size_t input_limit, ordering order, const Args&... args) const
+                -> replicated_stage<StageT>
+                {
+                    auto ret = replicated_stage<StageT>{replicas, input_limit, order, args...};
+                    ret.set_thread_pool(pool_);
+                    return ret;
+                }
+
+                template <class StageT, template <class> class QueueT, class... Args>
+                auto make_replicated_stage(std::size_t replicas, std::size_t input_limit, ordering order, const Args&... args) const
+                -> replicated_stage<StageT, QueueT>
+                {
+                    auto ret = replicated_stage<StageT, QueueT>{replicas, input_limit, order, args...};
+                    ret.set_thread_pool(pool_);
+                    return ret;
+                }
+
+            protected:
+                pipeline_base() noexcept = default;
+                explicit pipeline_base(generic::thread_pool* pool) noexcept
+                : pool_{pool}
+                {}
+
+                generic::thread_pool* pool_ = nullptr;
         };
 
+        /*
+         * Every stage occupies one thread until it has finished. If a thread_pool is given the stages
+         * run on the pool, which must provide at least one thread per running stage and per replica.
+         */
         class pipeline : public pipeline_base
         {
             public:
+                pipeline() noexcept = default;
+                explicit pipeline(generic::thread_pool* pool) noexcept
+                : pipeline_base{pool}
+                {}
+
                 template <class Runnable>
                 auto run(Runnable& r) -> void
                 {
-
-                    futures_.emplace_back(std::async(std::launch::async, &Runnable::run, &r));
+                    futures_.emplace_back(detail::launch(pool_, [&r]() { r.run(); }));
                 }
 
                 template <class Runnable, class... Runnables>
@@ -85,29 +172,56 @@ namespace glados
                     run(std::forward<Runnables>(rs)...);
                 }
 
+                /*
+                 * Waits for every stage, even if one of them failed, and rethrows the first error.
+                 * Afterwards the pipeline can be run again.
+                 */
                 auto wait() -> void
                 {
-                    try
+                    auto error = std::exception_ptr{};
+                    for(auto&& f : futures_)
                     {
-                        for(auto&& f : futures_)
+                        try
+                        {
                             f.get();
+                        }
+                        catch(...)
+                        {
+                            if(error == nullptr)
+                                error = std::current_exception();
+                        }
                     }
-                    catch(...)
-                    {
-                        throw;
-                    }
+
+                    futures_.clear();
+                    if(error != nullptr)
+                        std::rethrow_exception(error);
                 }
 
             private:
                 std::vector<std::future<void>> futures_;
         };
 
-        template <class TaskT>
+        /*
+         * Runs the stages once per task. With a thread_pool the stages of every task run on the pool
+         * instead of freshly started threads, the pool needs one thread per stage and per replica. The
+         * loop popping the tasks runs on a thread of its own.
+         *
+         * By default a task has to leave the last stage before the next one enters the first stage.
+         * With tasks_in_flight > 1 every stage runs in a loop of its own and takes on the next task as
+         * soon as it is done with the current one, so up to tasks_in_flight tasks move through the
+         * stages at the same time. In this mode every stage has to read its input until
+         * end_of_stream and may have at most one producer.
+         *
+         * QueueT provides the tasks through try_pop(TaskT&), e.g. task_queue or a worker handle of a
+         * work_stealing_queue when several task_pipelines share the tasks. TaskT has to be default
+         * constructible.
+         */
+        template <class TaskT, class QueueT = task_queue<TaskT>>
         class task_pipeline : public pipeline_base
         {
             public:
-                task_pipeline(task_queue<TaskT>* queue) noexcept
-                : queue_{queue}
+                task_pipeline(QueueT* queue, generic::thread_pool* pool = nullptr, std::size_t tasks_in_flight = 1) noexcept
+                : pipeline_base{pool}, queue_{queue}, tasks_in_flight_{std::max(tasks_in_flight, std::size_t{1})}
                 {}
 
                 auto run() -> void
@@ -141,30 +255,98 @@ namespace glados
                     auto run_func = std::bind(&Runnable::run, &r);
                     auto assign_func = std::bind(&Runnable::assign_task, &r, std::placeholders::_1);
                             
+                    if((tasks_in_flight_ > 1) && (producers(r, 0) > 1))
+                        throw std::invalid_argument{"glados::pipeline::task_pipeline: overlapped tasks need stages with at most one producer"};
+
                     runs_.push_back(run_func);
                     assigns_.push_back(assign_func);
+                    resets_.push_back(make_reset(r, 0));
+                    reopens_.push_back(make_reopen(r, 0));
+                }
+
+                // stages close their queues at the end of every task, reopen them for the next one
+                template <class Runnable>
+                static auto make_reset(Runnable& r, int) -> decltype(r.reset_input(), std::function<void()>{})
+                {
+                    return [&r]() { r.reset_input(); };
+                }
+
+                template <class Runnable>
+                static auto make_reset(Runnable&, long) -> std::function<void()>
+                {
+                    return []() {};
+                }
+
+                template <class Runnable>
+                static auto make_reopen(Runnable& r, int) -> decltype(r.reopen_input(), std::function<void()>{})
+                {
+                    return [&r]() { r.reopen_input(); };
+                }
+
+                template <class Runnable>
+                static auto make_reopen(Runnable&, long) -> std::function<void()>
+                {
+                    return []() {};
+                }
+
+                template <class Runnable>
+                static auto producers(Runnable& r, int) -> decltype(r.producers())
+                {
+                    return r.producers();
+                }
+
+                template <class Runnable>
+                static auto producers(Runnable&, long) -> std::size_t
+                {
+                    return 0;
                 }
 
                 auto internal_run() -> void
+                {
+                    if(tasks_in_flight_ > 1)
+                        overlapped_run();
+                    else
+                        sequential_run();
+                }
+
+                auto sequential_run() -> void
                 {
                     try
                     {
                         if(queue_ != nullptr)
                         {
-                            while(!queue_->empty())
+                            auto task = TaskT{};
+                            for(auto t = detail::trace_task_base(); queue_->try_pop(task); ++t)
                             {
-                                auto task = queue_->pop();
-
+                                detail::trace_task_begin(t);
                                 for(auto&& assign_func : assigns_)
                                     assign_func(task);
 
                                 for(auto&& run_func : runs_)
-                                    stage_futures_.emplace_back(std::async(std::launch::async, run_func));
+                                    stage_futures_.emplace_back(detail::launch(pool_, run_func));
 
+                                // every stage has to stop before the first error is passed on
+                                auto error = std::exception_ptr{};
                                 for(auto&& f : stage_futures_)
-                                    f.get();
+                                {
+                                    try
+                                    {
+                                        f.get();
+                                    }
+                                    catch(...)
+                                    {
+                                        if(error == nullptr)
+                                            error = std::current_exception();
+                                    }
+                                }
 
                                 stage_futures_.clear();
+                                if(error != nullptr)
+                                    std::rethrow_exception(error);
+
+                                for(auto&& reset_func : resets_)
+                                    reset_func();
+                                detail::trace_task_end(t);
                             }
                         }
                     }
@@ -174,13 +356,131 @@ namespace glados
                     }
                 }
 
+                auto overlapped_run() -> void
+                {
+                    if((queue_ == nullptr) || runs_.empty())
+                        return;
+
+                    // every stage receives the tasks through a queue of its own
+                    auto n = runs_.size();
+                    auto tasks = std::vector<blocking_queue<TaskT>>(n);
+                    auto finished = std::vector<std::size_t>(n, 0);
+                    auto ids = detail::trace_task_base();
+                    std::atomic<bool> failed{false};
+                    std::mutex mutex;
+                    std::condition_variable cv;
+
+                    auto stage_loop = [&](std::size_t i) {
+                        try
+                        {
+                            for(auto first = true; !failed.load(); first = false)
+                            {
+                                auto task = tasks[i].pop();
+
+                                // the stream of the previous task has ended, the next one is queued behind it
+                                if(!first)
+                                    reopens_[i]();
+
+                                assigns_[i](task);
+                                runs_[i]();
+
+                                {
+                                    auto&& lock = std::lock_guard<std::mutex>{mutex};
+                                    ++finished[i];
+
+                                    // the last stage to finish a task ends its span
+                                    if(trace_enabled && (*std::min_element(std::begin(finished), std::end(finished)) == finished[i]))
+                                        detail::trace_task_end(ids + finished[i] - 1);
+                                }
+                                cv.notify_all();
+                            }
+                        }
+                        catch(const end_of_stream&)
+                        {
+                        }
+                        catch(...)
+                        {
+                            {
+                                auto&& lock = std::lock_guard<std::mutex>{mutex};
+                                failed.store(true);
+                            }
+                            cv.notify_all();
+                            for(auto&& t : tasks)
+                                t.cancel();
+                            throw;
+                        }
+                    };
+
+                    for(auto&& reset_func : resets_)
+                        reset_func();
+
+                    for(auto i = std::size_t{0}; i < n; ++i)
+                        stage_futures_.emplace_back(detail::launch(pool_, [&stage_loop, i]() { stage_loop(i); }));
+
+                    auto error = std::exception_ptr{};
+                    try
+                    {
+                        auto submitted = std::size_t{0};
+                        auto task = TaskT{};
+                        while(queue_->try_pop(task))
+                        {
+                            {
+                                // a task is in flight until every stage has finished it
+                                auto&& lock = std::unique_lock<std::mutex>{mutex};
+                                cv.wait(lock, [&]() {
+                                    return failed.load() || (submitted - *std::min_element(std::begin(finished), std::end(finished)) < tasks_in_flight_);
+                                });
+                            }
+
+                            if(failed.load())
+                                break;
+
+                            detail::trace_task_begin(ids + submitted);
+                            for(auto&& t : tasks)
+                                t.push(TaskT{task});
+                            ++submitted;
+                        }
+                    }
+                    catch(const end_of_stream&)
+                    {
+                        // a stage failed and cancelled the task queues
+                    }
+                    catch(...)
+                    {
+                        error = std::current_exception();
+                    }
+
+                    for(auto&& t : tasks)
+                        t.close();
+
+                    for(auto&& f : stage_futures_)
+                    {
+                        try
+                        {
+                            f.get();
+                        }
+                        catch(...)
+                        {
+                            if(error == nullptr)
+                                error = std::current_exception();
+                        }
+                    }
+                    stage_futures_.clear();
+
+                    if(error != nullptr)
+                        std::rethrow_exception(error);
+                }
+
             private:
-                task_queue<TaskT>* queue_;
+                QueueT* queue_;
+                std::size_t tasks_in_flight_;
                 std::vector<std::future<void>> stage_futures_;
                 std::future<void> exec_future_;
 
                 std::vector<std::function<void(TaskT)>> assigns_;
                 std::vector<std::function<void()>> runs_;
+                std::vector<std::function<void()>> resets_;
+                std::vector<std::function<void()>> reopens_;
         };
     }
 }
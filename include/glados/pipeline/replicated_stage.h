@@ -0,0 +1,539 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_REPLICATED_STAGE_H_
+#define GLADOS_PIPELINE_REPLICATED_STAGE_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glados/generic/thread_pool.h>
+#include <glados/pipeline/end_of_stream.h>
+#include <glados/pipeline/input_side.h>
+#include <glados/pipeline/launch.h>
+#include <glados/pipeline/metrics.h>
+#include <glados/pipeline/mpmc_queue.h>
+#include <glados/pipeline/output_side.h>
+#include <glados/pipeline/trace.h>
+#include <glados/pipeline/wait_policy.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        enum class ordering
+        {
+            unordered,
+            preserve
+        };
+
+        namespace detail
+        {
+            template <class T>
+            struct sequenced
+            {
+                std::size_t seq;
+                T value;
+            };
+
+            /*
+             * Forwards the outputs of the replicas in the order in which their inputs entered the
+             * stage. An input counts as done once its replica asks for the next input or stops. All
+             * outputs belonging to one input keep their relative order. Outputs which belong to no
+             * input, e.g. those a replica emits after its input has ended, follow all others at finish().
+             *
+             * A replica whose input is more than window inputs ahead of the oldest unfinished one waits
+             * before it emits, so a slow input bounds what is buffered behind it. Outputs are forwarded
+             * by one thread at a time outside the lock; a replica whose outputs are ready waits until
+             * they have been taken for forwarding.
+             */
+            template <class OutputT>
+            class reorder_buffer
+            {
+                public:
+                    auto set_output(output_side<OutputT>* out) noexcept -> void
+                    {
+                        out_ = out;
+                    }
+
+                    auto set_window(std::size_t window) noexcept -> void
+                    {
+                        window_ = std::max(window, std::size_t{1});
+                    }
+
+                    auto emit(std::size_t seq, OutputT&& t) -> void
+                    {
+                        auto lock = std::unique_lock<std::mutex>{mutex_};
+                        cv_.wait(lock, [this, seq]() { return seq < next_ + window_; });
+                        if(seq > next_)
+                        {
+                            pending_[seq].push_back(std::move(t));
+                            return;
+                        }
+
+                        ready_.push_back(std::move(t));
+                        forward(lock);
+                    }
+
+                    auto complete(std::size_t seq) -> void
+                    {
+                        auto lock = std::unique_lock<std::mutex>{mutex_};
+                        if(seq != next_)
+                        {
+                            done_.insert(seq);
+                            return;
+                        }
+
+                        while(true)
+                        {
+                            ++next_;
+                            take_pending(next_);
+
+                            auto it = done_.find(next_);
+                            if(it == std::end(done_))
+                                break;
+
+                            done_.erase(it);
+                        }
+
+                        cv_.notify_all();
+                        forward(lock);
+                    }
+
+                    auto emit_unsequenced(OutputT&& t) -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        unsequenced_.push_back(std::move(t));
+                    }
+
+                    // forwards everything still held, in order, once no replica is running anymore
+                    auto finish() -> void
+                    {
+                        auto lock = std::unique_lock<std::mutex>{mutex_};
+                        for(auto&& p : pending_)
+                            std::move(std::begin(p.second), std::end(p.second), std::back_inserter(ready_));
+                        pending_.clear();
+
+                        std::move(std::begin(unsequenced_), std::end(unsequenced_), std::back_inserter(ready_));
+                        unsequenced_.clear();
+
+                        forward(lock);
+                    }
+
+                    auto reset() -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        next_ = 0;
+                        pending_.clear();
+                        done_.clear();
+                        ready_.clear();
+                        unsequenced_.clear();
+                        forwarding_ = false;
+                    }
+
+                private:
+                    auto take_pending(std::size_t seq) -> void
+                    {
+                        auto it = pending_.find(seq);
+                        if(it == std::end(pending_))
+                            return;
+
+                        std::move(std::begin(it->second), std::end(it->second), std::back_inserter(ready_));
+                        pending_.erase(it);
+                    }
+
+                    // the caller's ready outputs are gone once this returns, either forwarded by itself or by another thread
+                    auto forward(std::unique_lock<std::mutex>& lock) -> void
+                    {
+                        cv_.wait(lock, [this]() { return !forwarding_ || ready_.empty(); });
+                        if(ready_.empty())
+                            return;
+
+                        forwarding_ = true;
+                        auto batch = std::vector<OutputT>{};
+                        try
+                        {
+                            while(!ready_.empty())
+                            {
+                                batch.clear();
+                                batch.swap(ready_);
+                                cv_.notify_all();
+
+                                lock.unlock();
+                                for(auto&& t : batch)
+                                    out_->output(std::move(t));
+                                lock.lock();
+                            }
+                        }
+                        catch(...)
+                        {
+                            if(!lock.owns_lock())
+                                lock.lock();
+                            forwarding_ = false;
+                            cv_.notify_all();
+                            throw;
+                        }
+
+                        forwarding_ = false;
+                        cv_.notify_all();
+                    }
+
+                private:
+                    std::mutex mutex_;
+                    std::condition_variable cv_;
+                    std::size_t next_ = 0;
+                    std::size_t window_ = 1;
+                    bool forwarding_ = false;
+                    std::map<std::size_t, std::vector<OutputT>> pending_;
+                    std::set<std::size_t> done_;
+                    std::vector<OutputT> ready_; // in order, next to be forwarded
+                    std::vector<OutputT> unsequenced_;
+                    output_side<OutputT>* out_ = nullptr;
+            };
+
+            template <>
+            class reorder_buffer<void>
+            {
+                public:
+                    auto set_output(output_side<void>*) noexcept -> void {}
+                    auto set_window(std::size_t) noexcept -> void {}
+                    auto complete(std::size_t) noexcept -> void {}
+                    auto finish() noexcept -> void {}
+                    auto reset() noexcept -> void {}
+            };
+        }
+
+        /*
+         * Runs 'replicas' instances of StageT which take their inputs from one shared queue. Every
+         * instance is constructed from the same arguments. With ordering::preserve the outputs leave
+         * the stage in input order, otherwise they leave as soon as they are produced. In the latter
+         * case the replicas output concurrently, so the following stage's queue has to support
+         * multiple producers. The stage closes its output after the last replica has stopped.
+         * run() works on the first replica itself and starts the others on the thread_pool given to
+         * set_thread_pool(), or on threads of their own without one.
+         */
+        template <class StageT, template <class> class QueueT = mpmc_queue>
+        class replicated_stage : public detail::input_port<typename StageT::input_type>
+                               , public output_side<typename StageT::output_type>
+                               , private detail::input_recorder
+                               , private detail::run_recorder
+                               , private detail::trace_label
+        {
+            public:
+                using input_type = typename StageT::input_type;
+                using output_type = typename StageT::output_type;
+                using queue_type = QueueT<detail::sequenced<input_type>>;
+                using size_type = std::size_t;
+
+                using detail::trace_label::set_trace_name;
+
+                static_assert(!std::is_void<input_type>::value, "Sources can not be replicated.");
+                static_assert(queue_type::multi_consumer, "The replicas share one queue which must support multiple consumers.");
+
+            public:
+                template <class... Args>
+                replicated_stage(size_type replicas, size_type input_limit, ordering order, const Args&... args)
+                : output_side<output_type>()
+                , queue_{input_limit}, order_{order}, state_{new shared_state{}}
+                , slots_(std::max(replicas, size_type{1}))
+                {
+                    // outputs may run as far ahead of the oldest unfinished input as inputs may queue up
+                    state_->reorder.set_window(std::max(input_limit, 2 * slots_.size()));
+                    for(auto i = size_type{0}; i < slots_.size(); ++i)
+                        instances_.emplace_back(new StageT(args...));
+                }
+
+                replicated_stage(replicated_stage&& other) = default;
+                auto operator=(replicated_stage&& other) -> replicated_stage& = default;
+
+                template <class T>
+                auto input(T&& t) -> typename std::enable_if<std::is_same<input_type, T>::value, void>::type
+                {
+                    push(std::forward<T>(t));
+                }
+
+                auto push(input_type&& t) -> void override
+                {
+                    if(order_ == ordering::unordered)
+                        queue_.push(detail::sequenced<input_type>{0, std::move(t)});
+                    else
+                        push_sequenced(std::move(t));
+                    this->record_depth(queue_);
+                }
+
+                auto size() const noexcept -> std::size_t override
+                {
+                    return queue_.size();
+                }
+
+                auto close_input() -> void override
+                {
+                    queue_.close();
+                }
+
+                auto cancel_input() -> void
+                {
+                    queue_.cancel();
+                }
+
+                /* Moves on to the next stream once the current one has ended, keeping queued elements */
+                auto reopen_input() -> void
+                {
+                    queue_.reopen();
+                    this->reopen_producers();
+                }
+
+                /* Drops all elements for another run. Must not be called while the stage is running */
+                auto reset_input() -> void
+                {
+                    queue_.reset();
+                    state_->input_seq = 0;
+                    state_->reorder.reset();
+                    for(auto&& s : slots_)
+                        s.busy = false;
+                    this->reopen_producers();
+                }
+
+                /* Must not be called while the stage is running */
+                auto set_wait_policy(wait_policy policy) noexcept -> void
+                {
+                    queue_.set_wait_policy(policy);
+                }
+
+                /* Must not be called while the stage is running */
+                auto set_thread_pool(generic::thread_pool* pool) noexcept -> void
+                {
+                    pool_ = pool;
+                }
+
+                auto replicas() const noexcept -> size_type
+                {
+                    return instances_.size();
+                }
+
+                /* Times are summed over all replicas. All zero unless GLADOS_PIPELINE_METRICS is defined */
+                auto metrics() const noexcept -> stage_metrics
+                {
+                    auto m = stage_metrics{};
+                    this->collect_input_metrics(m);
+                    this->collect_output_metrics(m);
+                    this->collect_run_metrics(m);
+                    return m;
+                }
+
+                auto reset_metrics() noexcept -> void
+                {
+                    this->reset_input_metrics();
+                    this->reset_output_metrics();
+                    this->reset_run_metrics();
+                }
+
+                auto run() -> void
+                {
+                    state_->reorder.set_output(this);
+                    for(auto i = size_type{0}; i < instances_.size(); ++i)
+                    {
+                        slots_[i].input_ended = false;
+                        instances_[i]->set_input_function([this, i]() { return take(i); });
+                        set_output<output_type>(i);
+                    }
+
+                    auto futures = std::vector<std::future<void>>{};
+                    for(auto i = size_type{1}; i < instances_.size(); ++i)
+                        futures.emplace_back(detail::launch(pool_, [this, i]() { run_instance(i); }));
+
+                    auto error = std::exception_ptr{};
+                    try
+                    {
+                        run_instance(0);
+                    }
+                    catch(...)
+                    {
+                        error = std::current_exception();
+                    }
+
+                    for(auto&& f : futures)
+                    {
+                        try
+                        {
+                            f.get();
+                        }
+                        catch(...)
+                        {
+                            if(error == nullptr)
+                                error = std::current_exception();
+                        }
+                    }
+
+                    auto input_ended = std::all_of(std::begin(slots_), std::end(slots_), [](const slot& s) { return s.input_ended; });
+                    if((error != nullptr) || !input_ended)
+                        cancel_input();
+
+                    if((error == nullptr) && (order_ == ordering::preserve))
+                        state_->reorder.finish();
+                    this->close_output();
+
+                    if(error != nullptr)
+                        std::rethrow_exception(error);
+                }
+
+            private:
+                struct shared_state
+                {
+                    std::mutex push_mutex;
+                    std::size_t input_seq = 0; // guarded by push_mutex
+                    detail::reorder_buffer<output_type> reorder;
+                };
+
+                struct slot
+                {
+                    std::size_t seq = 0;
+                    bool busy = false;
+                    bool input_ended = false;
+                };
+
+                /*
+                 * Sequence numbers enter the queue in order, even with several producers: one which
+                 * waits for room holds the others back instead of leaving a gap the replicas would
+                 * wait for while it can't get into the queue they no longer drain.
+                 */
+                auto push_sequenced(input_type&& t) -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{state_->push_mutex};
+                    auto seq = state_->input_seq++;
+                    try
+                    {
+                        queue_.push(detail::sequenced<input_type>{seq, std::move(t)});
+                    }
+                    catch(...)
+                    {
+                        // no replica will see this input, don't let the outputs wait for it
+                        state_->reorder.complete(seq);
+                        throw;
+                    }
+                }
+
+                auto run_instance(size_type i) -> void
+                {
+                    auto watch = detail::stopwatch{};
+                    this->trace_run_begin();
+                    try
+                    {
+                        instances_[i]->run();
+                    }
+                    catch(const end_of_stream&)
+                    {
+                    }
+                    catch(...)
+                    {
+                        this->trace_run_end();
+                        this->record_run(watch);
+                        // stop the other replicas, too
+                        release(i);
+                        cancel_input();
+                        throw;
+                    }
+
+                    this->trace_run_end();
+                    this->record_run(watch);
+                    release(i);
+                }
+
+                auto release(size_type i) -> void
+                {
+                    if(slots_[i].busy && (order_ == ordering::preserve))
+                        state_->reorder.complete(slots_[i].seq);
+
+                    slots_[i].busy = false;
+                }
+
+                auto take(size_type i) -> input_type
+                {
+                    release(i);
+                    this->trace_item_end();
+
+                    auto item = pop(i);
+                    this->trace_item_begin();
+                    slots_[i].seq = item.seq;
+                    slots_[i].busy = true;
+                    return std::move(item.value);
+                }
+
+                auto pop(size_type i) -> detail::sequenced<input_type>
+                {
+                    try
+                    {
+                        auto watch = detail::stopwatch{};
+                        auto ret = queue_.pop();
+                        this->record_take(watch);
+                        return ret;
+                    }
+                    catch(const end_of_stream&)
+                    {
+                        slots_[i].input_ended = true;
+                        throw;
+                    }
+                }
+
+                template <class O>
+                auto set_output(size_type) noexcept
+                -> typename std::enable_if<std::is_void<O>::value, void>::type
+                {}
+
+                template <class O>
+                auto set_output(size_type i)
+                -> typename std::enable_if<!std::is_void<O>::value, void>::type
+                {
+                    instances_[i]->set_output_function([this, i](O t) {
+                        if(order_ == ordering::unordered)
+                            this->output(std::move(t));
+                        else if(slots_[i].busy)
+                            state_->reorder.emit(slots_[i].seq, std::move(t));
+                        else
+                            state_->reorder.emit_unsequenced(std::move(t));
+                    });
+                }
+
+            private:
+                queue_type queue_;
+                ordering order_;
+                std::unique_ptr<shared_state> state_;
+                std::vector<slot> slots_;
+                std::vector<std::unique_ptr<StageT>> instances_;
+                generic::thread_pool* pool_ = nullptr;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_REPLICATED_STAGE_H_ */
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_SPSC_QUEUE_H_
+#define GLADOS_PIPELINE_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <glados/pipeline/end_of_stream.h>
+#include <glados/pipeline/wait_policy.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Bounded lock-free ring buffer for exactly one producer and one consumer thread. The buffer
+         * is allocated once on construction, pushing and popping never allocate. Producer and
+         * consumer indices live on separate cache lines and each side caches the other side's index
+         * so that the shared lines are only touched when the cached value runs out.
+         *
+         * The mutex and condition variables are only used once a thread has to park, see wait_policy.
+         * A limit of 0 selects default_capacity since the buffer can not grow. close(), reopen() and
+         * cancel() behave like their blocking_queue counterparts.
+         */
+        template <class T>
+        class spsc_queue
+        {
+            private:
+                using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+            public:
+                using size_type = std::size_t;
+
+                static constexpr auto default_capacity = size_type{1024};
+                static constexpr auto multi_producer = false;
+                static constexpr auto multi_consumer = false;
+
+            public:
+                spsc_queue() : spsc_queue(0) {}
+                spsc_queue(size_type limit, wait_policy policy = spin_then_park)
+                : limit_{(limit == 0) ? default_capacity : limit}
+                , mask_{round_up_pow2(limit_) - 1}
+                , buffer_{new storage_type[mask_ + 1]}
+                , policy_{policy}, cancelled_{false}
+                , head_{0}, tail_cache_{0}, consumer_waiting_{false}
+                , tail_{0}, head_cache_{0}, producer_waiting_{false}
+                {}
+
+                spsc_queue(const spsc_queue& other) = delete;
+                auto operator=(const spsc_queue& other) -> spsc_queue& = delete;
+
+                /* Moving is only allowed while neither side is in use */
+                spsc_queue(spsc_queue&& other) noexcept
+                : limit_{other.limit_}, mask_{other.mask_}, buffer_{std::move(other.buffer_)}, policy_{other.policy_}
+                , ends_{std::move(other.ends_)}, cancelled_{other.cancelled_.load()}
+                , head_{other.head_.load()}, tail_cache_{other.tail_cache_}, consumer_waiting_{false}
+                , tail_{other.tail_.load()}, head_cache_{other.head_cache_}, producer_waiting_{false}
+                {
+                    other.head_.store(0);
+                    other.tail_.store(0);
+                }
+
+                auto operator=(spsc_queue&& other) noexcept -> spsc_queue&
+                {
+                    if(this != &other)
+                    {
+                        destroy_elements();
+                        limit_ = other.limit_;
+                        mask_ = other.mask_;
+                        buffer_ = std::move(other.buffer_);
+                        policy_ = other.policy_;
+                        ends_ = std::move(other.ends_);
+                        cancelled_.store(other.cancelled_.load());
+                        head_.store(other.head_.load());
+                        tail_cache_ = other.tail_cache_;
+                        tail_.store(other.tail_.load());
+                        head_cache_ = other.head_cache_;
+                        other.head_.store(0);
+                        other.tail_.store(0);
+                    }
+
+                    return *this;
+                }
+
+                ~spsc_queue()
+                {
+                    destroy_elements();
+                }
+
+                auto push(T&& t) -> void
+                {
+                    if(cancelled_.load(std::memory_order_relaxed))
+                        throw end_of_stream{};
+
+                    auto tail = tail_.load(std::memory_order_relaxed);
+                    if(tail - head_cache_ >= limit_)
+                    {
+                        wait_for(producer_waiting_, not_full_, [this, tail]() {
+                            head_cache_ = head_.load(std::memory_order_acquire);
+                            return (tail - head_cache_ < limit_) || cancelled_.load(std::memory_order_acquire);
+                        });
+
+                        if(tail - head_cache_ >= limit_)
+                            throw end_of_stream{};
+                    }
+
+                    ::new(static_cast<void*>(&buffer_[tail & mask_])) T(std::move(t));
+                    tail_.store(tail + 1, std::memory_order_release);
+
+                    wake(consumer_waiting_, not_empty_);
+                }
+
+                auto pop() -> T
+                {
+                    auto head = head_.load(std::memory_order_relaxed);
+                    if(head == tail_cache_)
+                    {
+                        wait_for(consumer_waiting_, not_empty_, [this, head]() {
+                            tail_cache_ = tail_.load(std::memory_order_acquire);
+                            return (head != tail_cache_) || ends_.closed() || cancelled_.load(std::memory_order_acquire);
+                        });
+
+                        if(head == tail_cache_)
+                        {
+                            // pick up elements pushed right before close()
+                            tail_cache_ = tail_.load(std::memory_order_acquire);
+                            if(head == tail_cache_)
+                                throw end_of_stream{};
+                        }
+                    }
+
+                    // read after the element became visible, so an earlier close() is visible, too
+                    if(ends_.reached(head))
+                        throw end_of_stream{};
+
+                    auto slot = reinterpret_cast<T*>(&buffer_[head & mask_]);
+                    auto ret = std::move(*slot);
+                    slot->~T();
+                    head_.store(head + 1, std::memory_order_release);
+
+                    wake(producer_waiting_, not_full_);
+                    return ret;
+                }
+
+                /* Called by the producer or after the producer has finished */
+                auto close() -> void
+                {
+                    ends_.close(tail_.load(std::memory_order_acquire));
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    not_empty_.notify_all();
+                }
+
+                /* Called by the consumer after it received end_of_stream */
+                auto reopen() -> void
+                {
+                    ends_.reopen();
+                }
+
+                /* May be called from any thread, releases both sides */
+                auto cancel() -> void
+                {
+                    cancelled_.store(true, std::memory_order_release);
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    not_empty_.notify_all();
+                    not_full_.notify_all();
+                }
+
+                /* Drops all elements and undoes close() and cancel(). Must not be called while the queue is in use */
+                auto reset() -> void
+                {
+                    destroy_elements();
+                    head_.store(0);
+                    tail_.store(0);
+                    tail_cache_ = 0;
+                    head_cache_ = 0;
+                    ends_.reset();
+                    cancelled_.store(false);
+                }
+
+                auto closed() const noexcept -> bool
+                {
+                    return ends_.closed();
+                }
+
+                auto set_wait_policy(wait_policy policy) noexcept -> void
+                {
+                    policy_ = policy;
+                }
+
+                auto size() const noexcept -> size_type
+                {
+                    auto head = head_.load(std::memory_order_acquire);
+                    return tail_.load(std::memory_order_acquire) - head;
+                }
+
+            private:
+                static auto round_up_pow2(size_type n) noexcept -> size_type
+                {
+                    auto ret = size_type{1};
+                    while(ret < n)
+                        ret <<= 1;
+                    return ret;
+                }
+
+                template <class Predicate>
+                auto wait_for(std::atomic<bool>& waiting, std::condition_variable& cv, Predicate pred) -> void
+                {
+                    static const auto multi_core = std::thread::hardware_concurrency() > 1u;
+                    auto spins = multi_core ? policy_.spins : size_type{0};
+                    for(auto i = size_type{0}; i < spins; ++i)
+                    {
+                        if(pred())
+                            return;
+
+                        detail::cpu_relax();
+                    }
+
+                    if(!policy_.park)
+                    {
+                        while(!pred())
+                            std::this_thread::yield();
+                        return;
+                    }
+
+                    // announce ourselves before the final check, wake() checks the flag after publishing
+                    auto&& lock = std::unique_lock<std::mutex>{mutex_};
+                    waiting.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    cv.wait(lock, pred);
+                    waiting.store(false, std::memory_order_relaxed);
+                }
+
+                auto wake(std::atomic<bool>& waiting, std::condition_variable& cv) -> void
+                {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if(waiting.load(std::memory_order_relaxed))
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        cv.notify_one();
+                    }
+                }
+
+                auto destroy_elements() noexcept -> void
+                {
+                    if(buffer_ == nullptr)
+                        return;
+
+                    for(auto i = head_.load(); i != tail_.load(); ++i)
+                        reinterpret_cast<T*>(&buffer_[i & mask_])->~T();
+                }
+
+            private:
+                static constexpr auto cache_line = size_type{64};
+
+                size_type limit_;
+                size_type mask_;
+                std::unique_ptr<storage_type[]> buffer_;
+                wait_policy policy_;
+                detail::stream_ends ends_;
+                std::atomic<bool> cancelled_;
+                char pad0_[cache_line];
+
+                // consumer side
+                std::atomic<size_type> head_;
+                size_type tail_cache_;
+                std::atomic<bool> consumer_waiting_;
+                char pad1_[cache_line];
+
+                // producer side
+                std::atomic<size_type> tail_;
+                size_type head_cache_;
+                std::atomic<bool> producer_waiting_;
+                char pad2_[cache_line];
+
+                std::mutex mutex_;
+                std::condition_variable not_empty_;
+                std::condition_variable not_full_;
+        };
+
+        template <class T>
+        constexpr typename spsc_queue<T>::size_type spsc_queue<T>::default_capacity;
+    }
+}
+
+#endif /* GLADOS_PIPELINE_SPSC_QUEUE_H_ */
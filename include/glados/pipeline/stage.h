@@ -28,35 +28,54 @@
 #include <type_traits>
 #include <utility>
 
+#include <glados/pipeline/blocking_queue.h>
+#include <glados/pipeline/end_of_stream.h>
 #include <glados/pipeline/input_side.h>
+#include <glados/pipeline/metrics.h>
 #include <glados/pipeline/output_side.h>
+#include <glados/pipeline/trace.h>
 
 namespace glados
 {
     namespace pipeline
     {
-        template <class StageT>
+        /*
+         * QueueT selects the queue between this stage and its predecessor, e.g. spsc_queue for a
+         * lock-free hand-off in a linear pipeline.
+         *
+         * Once StageT::run returns or throws, the stage closes its output, so the end of the stream
+         * travels downstream to the sink. If StageT::run stops before the end of its input, the input
+         * is cancelled and producers still pushing into this stage receive end_of_stream and stop as
+         * well. reset_input() prepares the stage for another run, reopen_input() for the next stream
+         * already queued behind the current one.
+         */
+        template <class StageT, template <class> class QueueT = blocking_queue>
         class stage : public StageT
-                    , public input_side<typename StageT::input_type>
+                    , public input_side<typename StageT::input_type, QueueT<typename StageT::input_type>>
                     , public output_side<typename StageT::output_type>
+                    , private detail::run_recorder
+                    , private detail::trace_label
         {
             public:
                 using input_type = typename StageT::input_type;
                 using output_type = typename StageT::output_type;
+                using queue_type = QueueT<input_type>;
                 using size_type = std::size_t;
 
+                using detail::trace_label::set_trace_name;
+
             public:
                 template <class... Args>
                 stage(Args&&... args)
                 : StageT(std::forward<Args>(args)...)
-                , input_side<input_type>()
+                , input_side<input_type, queue_type>()
                 , output_side<output_type>()
                 {}
 
                 template <class... Args>
                 stage(size_type input_limit, Args&&... args)
                 : StageT(std::forward<Args>(args)...)
-                , input_side<input_type>(input_limit)
+                , input_side<input_type, queue_type>(input_limit)
                 , output_side<output_type>()
                 {}
 
@@ -64,10 +83,89 @@ namespace glados
                 {
                     set_input<input_type>();
                     set_output<output_type>();
-                    StageT::run();
+
+                    input_ended_ = false;
+                    auto watch = detail::stopwatch{};
+                    this->trace_run_begin();
+                    // a source's items are the spans between two outputs
+                    if(std::is_same<input_type, void>::value)
+                        this->trace_item_begin();
+
+                    try
+                    {
+                        StageT::run();
+                    }
+                    catch(const end_of_stream&)
+                    {
+                    }
+                    catch(...)
+                    {
+                        this->trace_run_end();
+                        this->record_run(watch);
+                        this->cancel_input();
+                        this->close_output();
+                        throw;
+                    }
+
+                    this->trace_run_end();
+                    this->record_run(watch);
+                    finish();
+                }
+
+                /* All zero unless GLADOS_PIPELINE_METRICS is defined */
+                auto metrics() const noexcept -> stage_metrics
+                {
+                    auto m = stage_metrics{};
+                    this->collect_input_metrics(m);
+                    this->collect_output_metrics(m);
+                    this->collect_run_metrics(m);
+                    return m;
+                }
+
+                auto reset_metrics() noexcept -> void
+                {
+                    this->reset_input_metrics();
+                    this->reset_output_metrics();
+                    this->reset_run_metrics();
                 }
 
             private:
+                auto finish() -> void
+                {
+                    if(!input_ended_)
+                        this->cancel_input();
+
+                    this->close_output();
+                }
+
+                auto take_input() -> input_type
+                {
+                    this->trace_item_end();
+                    try
+                    {
+                        auto ret = this->take();
+                        this->trace_item_begin();
+                        return ret;
+                    }
+                    catch(const end_of_stream&)
+                    {
+                        input_ended_ = true;
+                        throw;
+                    }
+                }
+
+                template <class O>
+                auto emit(O t) -> void
+                {
+                    if(std::is_same<input_type, void>::value)
+                        this->trace_item_end();
+
+                    this->template output<O>(std::move(t));
+
+                    if(std::is_same<input_type, void>::value)
+                        this->trace_item_begin();
+                }
+
                 template <class I>
                 auto set_input() const noexcept
                 -> typename std::enable_if<std::is_same<void, I>::value && std::is_same<input_type, I>::value, void>::type
@@ -77,7 +175,7 @@ namespace glados
                 auto set_input()
                 -> typename std::enable_if<!std::is_same<void, I>::value && std::is_same<input_type, I>::value, void>::type
                 {
-                    StageT::set_input_function(std::bind(&input_side<input_type>::take, this));
+                    StageT::set_input_function(std::bind(&stage::take_input, this));
                 }
 
                 template <class O>
@@ -89,8 +187,11 @@ namespace glados
                 auto set_output()
                 -> typename std::enable_if<!std::is_same<void, O>::value && std::is_same<output_type, O>::value, void>::type
                 {
-                    StageT::set_output_function(std::bind(&output_side<output_type>::template output<output_type>, this, std::placeholders::_1));
+                    StageT::set_output_function(std::bind(&stage::template emit<output_type>, this, std::placeholders::_1));
                 }
+
+            private:
+                bool input_ended_ = false;
         };
     }
 }
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_STAGE_GROUP_H_
+#define GLADOS_PIPELINE_STAGE_GROUP_H_
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <glados/pipeline/input_side.h>
+#include <glados/pipeline/output_side.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        namespace detail
+        {
+            template <class... Ts>
+            struct all_true : std::true_type {};
+
+            template <class T, class... Ts>
+            struct all_true<T, Ts...> : std::integral_constant<bool, T::value && all_true<Ts...>::value> {};
+        }
+
+        /*
+         * A set of stages running side by side. Connecting a stage to a group distributes the stage's
+         * output among the group (fan-out), connecting a group to a stage merges the outputs of the
+         * group into the stage (fan-in). The group only refers to its stages, it does not own them.
+         */
+        template <class... Stages>
+        class stage_group
+        {
+            public:
+                using first_type = typename std::tuple_element<0, std::tuple<Stages...>>::type;
+                using input_type = typename first_type::input_type;
+                using output_type = typename first_type::output_type;
+
+                static_assert(detail::all_true<std::is_same<input_type, typename Stages::input_type>...>::value,
+                              "All stages of a group must have the same input type.");
+                static_assert(detail::all_true<std::is_same<output_type, typename Stages::output_type>...>::value,
+                              "All stages of a group must have the same output type.");
+
+            public:
+                stage_group(distribution d, Stages&... stages)
+                : distribution_{d}
+                , inputs_{static_cast<detail::input_port<input_type>*>(&stages)...}
+                , outputs_{static_cast<output_side<output_type>*>(&stages)...}
+                {}
+
+                auto get_distribution() const noexcept -> distribution
+                {
+                    return distribution_;
+                }
+
+                auto inputs() const -> const std::vector<detail::input_port<input_type>*>&
+                {
+                    return inputs_;
+                }
+
+                auto outputs() const -> const std::vector<output_side<output_type>*>&
+                {
+                    return outputs_;
+                }
+
+            private:
+                distribution distribution_;
+                std::vector<detail::input_port<input_type>*> inputs_;
+                std::vector<output_side<output_type>*> outputs_;
+        };
+
+        template <class... Stages>
+        auto parallel(Stages&... stages) -> stage_group<Stages...>
+        {
+            return stage_group<Stages...>{distribution::round_robin, stages...};
+        }
+
+        template <class... Stages>
+        auto parallel(distribution d, Stages&... stages) -> stage_group<Stages...>
+        {
+            return stage_group<Stages...>{d, stages...};
+        }
+    }
+}
+
+#endif /* GLADOS_PIPELINE_STAGE_GROUP_H_ */
@@ -31,6 +31,10 @@ namespace glados
 {
     namespace pipeline
     {
+        /*
+         * Mutex-protected FIFO of tasks. Several task_pipelines may share one task_queue as long as
+         * they take their tasks with try_pop, empty() followed by pop() can race with other consumers.
+         */
         template <class TaskT>
         class task_queue
         {
@@ -55,14 +59,26 @@ namespace glados
                     return ret;
                 }
 
+                auto try_pop(TaskT& t) -> bool
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    if(queue_.empty())
+                        return false;
+
+                    t = std::move(queue_.front());
+                    queue_.pop();
+                    return true;
+                }
+
                 auto empty() const -> bool
                 {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
                     return queue_.empty();
                 }
 
             private:
                 std::queue<TaskT> queue_;
-                std::mutex mutex_;
+                mutable std::mutex mutex_;
         };
     }
 }
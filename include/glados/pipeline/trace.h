@@ -0,0 +1,355 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_TRACE_H_
+#define GLADOS_PIPELINE_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Define GLADOS_PIPELINE_TRACE before including the pipeline headers to record a timeline of
+         * the pipeline: one span per stage run, one per item a stage works on and one per task of a
+         * task_pipeline. tracer::instance().write() dumps the recorded events in the Chrome trace
+         * format which chrome://tracing and ui.perfetto.dev can open. Without the macro all trace
+         * points compile to nothing.
+         */
+#ifdef GLADOS_PIPELINE_TRACE
+        constexpr auto trace_enabled = true;
+#else
+        constexpr auto trace_enabled = false;
+#endif
+
+        namespace detail
+        {
+            struct trace_event
+            {
+                const char* name;
+                std::uint64_t id;
+                std::int64_t ts; // ns since the tracer was created
+                char phase;
+            };
+
+            // written by its thread only, read by write() afterwards
+            struct trace_buffer
+            {
+                trace_buffer(std::size_t capacity, std::uint32_t thread_id)
+                : events(capacity), tid{thread_id}
+                {}
+
+                std::vector<trace_event> events;
+                std::atomic<std::size_t> size{0};
+                std::atomic<std::size_t> dropped{0};
+                std::uint32_t tid;
+                bool item_open = false;
+            };
+        }
+
+        /*
+         * Collects the trace events of all threads. Every thread appends to a buffer of its own
+         * without any locking, a full buffer drops further events. The buffer of a thread which
+         * exited keeps its events and is handed to the next thread which starts recording.
+         * Recording starts with start(). clear() and write() must not be called while a traced
+         * pipeline is running.
+         */
+        class tracer
+        {
+            public:
+                static auto instance() -> tracer&
+                {
+                    static tracer t;
+                    return t;
+                }
+
+                tracer(const tracer&) = delete;
+                auto operator=(const tracer&) -> tracer& = delete;
+
+                auto start() noexcept -> void { enabled_.store(true, std::memory_order_relaxed); }
+                auto stop() noexcept -> void { enabled_.store(false, std::memory_order_relaxed); }
+                auto enabled() const noexcept -> bool { return enabled_.load(std::memory_order_relaxed); }
+
+                /* number of events each thread can record, applies to threads which did not record yet */
+                auto set_buffer_capacity(std::size_t events) noexcept -> void
+                {
+                    capacity_.store(events, std::memory_order_relaxed);
+                }
+
+                // the returned pointer stays valid for the lifetime of the program
+                auto intern(const std::string& name) -> const char*
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    names_.push_back(name);
+                    return names_.back().c_str();
+                }
+
+                auto dropped() const -> std::size_t
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    auto ret = std::size_t{0};
+                    for(auto&& b : buffers_)
+                        ret += b->dropped.load(std::memory_order_relaxed);
+                    return ret;
+                }
+
+                auto clear() -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    for(auto&& b : buffers_)
+                    {
+                        b->size.store(0, std::memory_order_relaxed);
+                        b->dropped.store(0, std::memory_order_relaxed);
+                        b->item_open = false;
+                    }
+                }
+
+                auto write(std::ostream& os) const -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    os << "{\"traceEvents\":[";
+                    auto first = true;
+                    for(auto&& b : buffers_)
+                    {
+                        auto n = b->size.load(std::memory_order_acquire);
+                        for(auto i = std::size_t{0}; i < n; ++i)
+                        {
+                            os << (first ? "\n" : ",\n");
+                            write_event(os, b->events[i], b->tid);
+                            first = false;
+                        }
+                    }
+                    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+                }
+
+                auto write(const std::string& path) const -> void
+                {
+                    auto file = std::ofstream{path};
+                    if(!file)
+                        throw std::runtime_error{"glados::pipeline::tracer: cannot open " + path};
+                    write(file);
+                }
+
+                auto record(char phase, const char* name, std::uint64_t id = 0) noexcept -> void
+                {
+                    if(!enabled())
+                        return;
+
+                    auto b = local_buffer(true);
+                    if(b == nullptr)
+                        return;
+
+                    append(*b, phase, name, id);
+                }
+
+                /* ends the item the calling thread worked on, if any, and begins the next one if name != nullptr */
+                auto next_item(const char* name) noexcept -> void
+                {
+                    // an item opened while recording is closed even after stop()
+                    auto b = local_buffer(enabled());
+                    if(b == nullptr)
+                        return;
+
+                    if(b->item_open)
+                        append(*b, 'E', "item", 0);
+
+                    b->item_open = (name != nullptr) && enabled();
+                    if(b->item_open)
+                        append(*b, 'B', name, 0);
+                }
+
+            private:
+                tracer() : epoch_{std::chrono::steady_clock::now()} {}
+
+                // gives the buffer of the calling thread back to the tracer when the thread exits
+                struct local_slot
+                {
+                    ~local_slot()
+                    {
+                        if(buffer != nullptr)
+                            tracer::instance().retire(*buffer);
+                    }
+
+                    detail::trace_buffer* buffer = nullptr;
+                };
+
+                auto local_buffer(bool create) noexcept -> detail::trace_buffer*
+                {
+                    static thread_local local_slot slot;
+                    if((slot.buffer == nullptr) && create)
+                    {
+                        try
+                        {
+                            auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                            if(retired_.empty())
+                            {
+                                auto tid = static_cast<std::uint32_t>(buffers_.size() + 1);
+                                buffers_.emplace_back(new detail::trace_buffer{capacity_.load(std::memory_order_relaxed), tid});
+                                slot.buffer = buffers_.back().get();
+                            }
+                            else
+                            {
+                                slot.buffer = retired_.back();
+                                retired_.pop_back();
+                            }
+                        }
+                        catch(...)
+                        {
+                            return nullptr;
+                        }
+                    }
+                    return slot.buffer;
+                }
+
+                auto retire(detail::trace_buffer& b) noexcept -> void
+                {
+                    if(b.item_open)
+                        append(b, 'E', "item", 0);
+                    b.item_open = false;
+
+                    try
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        retired_.push_back(&b);
+                    }
+                    catch(...)
+                    {
+                        // the buffer stays in buffers_ and is merely not reused
+                    }
+                }
+
+                auto append(detail::trace_buffer& b, char phase, const char* name, std::uint64_t id) noexcept -> void
+                {
+                    auto n = b.size.load(std::memory_order_relaxed);
+                    if(n == b.events.size())
+                    {
+                        b.dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    auto now = std::chrono::steady_clock::now();
+                    b.events[n] = detail::trace_event{name, id, std::chrono::duration_cast<std::chrono::nanoseconds>(now - epoch_).count(), phase};
+                    b.size.store(n + 1, std::memory_order_release);
+                }
+
+                static auto write_event(std::ostream& os, const detail::trace_event& e, std::uint32_t tid) -> void
+                {
+                    os << "{\"name\":\"";
+                    for(auto c = e.name; *c != '\0'; ++c)
+                    {
+                        if((*c == '"') || (*c == '\\'))
+                            os << '\\';
+                        os << *c;
+                    }
+
+                    char ts[32];
+                    std::snprintf(ts, sizeof(ts), "%.3f", static_cast<double>(e.ts) / 1000.0);
+                    os << "\",\"cat\":\"glados\",\"ph\":\"" << e.phase << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << tid;
+
+                    // async events are matched by their id instead of their thread
+                    if((e.phase == 'b') || (e.phase == 'e'))
+                        os << ",\"id\":" << e.id;
+                    os << "}";
+                }
+
+            private:
+                std::chrono::steady_clock::time_point epoch_;
+                std::atomic<bool> enabled_{false};
+                std::atomic<std::size_t> capacity_{std::size_t{1} << 16};
+                mutable std::mutex mutex_;
+                std::vector<std::unique_ptr<detail::trace_buffer>> buffers_;
+                std::vector<detail::trace_buffer*> retired_;
+                std::deque<std::string> names_;
+        };
+
+        namespace detail
+        {
+#ifdef GLADOS_PIPELINE_TRACE
+            /* The trace points of a stage, the name defaults to 'stage' */
+            class trace_label
+            {
+                public:
+                    auto set_trace_name(const std::string& name) -> void
+                    {
+                        name_ = tracer::instance().intern(name);
+                    }
+
+                protected:
+                    auto trace_run_begin() const noexcept -> void { tracer::instance().record('B', name_); }
+
+                    auto trace_run_end() const noexcept -> void
+                    {
+                        tracer::instance().next_item(nullptr);
+                        tracer::instance().record('E', name_);
+                    }
+
+                    auto trace_item_begin() const noexcept -> void { tracer::instance().next_item("item"); }
+                    auto trace_item_end() const noexcept -> void { tracer::instance().next_item(nullptr); }
+
+                private:
+                    const char* name_ = "stage";
+            };
+
+            /* The first task id of a pipeline run, runs count their tasks from here so their spans don't share ids */
+            inline auto trace_task_base() noexcept -> std::uint64_t
+            {
+                static std::atomic<std::uint64_t> runs{0};
+                return runs.fetch_add(1, std::memory_order_relaxed) << 32;
+            }
+
+            inline auto trace_task_begin(std::uint64_t task) noexcept -> void { tracer::instance().record('b', "task", task); }
+            inline auto trace_task_end(std::uint64_t task) noexcept -> void { tracer::instance().record('e', "task", task); }
+#else
+            class trace_label
+            {
+                public:
+                    auto set_trace_name(const std::string&) noexcept -> void {}
+
+                protected:
+                    auto trace_run_begin() const noexcept -> void {}
+                    auto trace_run_end() const noexcept -> void {}
+                    auto trace_item_begin() const noexcept -> void {}
+                    auto trace_item_end() const noexcept -> void {}
+            };
+
+            inline auto trace_task_base() noexcept -> std::uint64_t { return 0; }
+            inline auto trace_task_begin(std::uint64_t) noexcept -> void {}
+            inline auto trace_task_end(std::uint64_t) noexcept -> void {}
+#endif
+        }
+    }
+}
+
+#endif /* GLADOS_PIPELINE_TRACE_H_ */
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_WAIT_POLICY_H_
+#define GLADOS_PIPELINE_WAIT_POLICY_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Describes how a pipeline thread waits on a full or empty queue. The thread polls the queue
+         * 'spins' times without taking any lock. Afterwards it either sleeps on a condition variable
+         * until it is woken up (park == true) or keeps yielding its time slice (park == false).
+         */
+        struct wait_policy
+        {
+            std::size_t spins;
+            bool park;
+        };
+
+        constexpr auto yield_wait = wait_policy{0u, false}; // old behaviour, keeps the core busy
+        constexpr auto block_wait = wait_policy{0u, true};
+        constexpr auto spin_then_park = wait_policy{1024u, true};
+
+        namespace detail
+        {
+            inline auto cpu_relax() noexcept -> void
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+
+            /*
+             * Expects an unlocked lock and returns with the lock held and pred() == true. pred must
+             * be safe to call without holding the lock.
+             */
+            template <class Lock, class Predicate>
+            auto wait(const wait_policy& policy, Lock& lock, std::condition_variable& cv, Predicate pred) -> void
+            {
+                // spinning on a single core only delays the thread we are waiting for
+                static const auto multi_core = std::thread::hardware_concurrency() > 1u;
+                auto spins = multi_core ? policy.spins : std::size_t{0};
+                for(auto i = std::size_t{0}; i < spins; ++i)
+                {
+                    if(pred())
+                        break;
+
+                    cpu_relax();
+                }
+
+                lock.lock();
+                if(policy.park)
+                    cv.wait(lock, pred);
+                else
+                {
+                    while(!pred())
+                    {
+                        lock.unlock();
+                        std::this_thread::yield();
+                        lock.lock();
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* GLADOS_PIPELINE_WAIT_POLICY_H_ */
@@ -0,0 +1,215 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_WORK_STEALING_QUEUE_H_
+#define GLADOS_PIPELINE_WORK_STEALING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Task queue for several consumers (e.g. one task_pipeline per GPU). Every consumer owns a
+         * local deque and takes its tasks from the front. Once the local deque runs dry it steals from
+         * the back of the other deques, so the consumers only meet on the same lock when one of them
+         * has run out of work. Initial tasks are split into contiguous blocks, one per consumer.
+         *
+         * A consumer talks to the queue through its worker handle, which provides the try_pop
+         * interface expected by task_pipeline.
+         */
+        template <class TaskT>
+        class work_stealing_queue
+        {
+            public:
+                using size_type = std::size_t;
+
+                class worker
+                {
+                    public:
+                        auto try_pop(TaskT& t) -> bool
+                        {
+                            return queue_->try_pop(index_, t);
+                        }
+
+                        auto push(TaskT&& t) -> void
+                        {
+                            queue_->push(index_, std::move(t));
+                        }
+
+                        auto index() const noexcept -> size_type
+                        {
+                            return index_;
+                        }
+
+                    private:
+                        friend class work_stealing_queue;
+
+                        worker(work_stealing_queue* queue, size_type index) noexcept
+                        : queue_{queue}, index_{index}
+                        {}
+
+                    private:
+                        work_stealing_queue* queue_;
+                        size_type index_;
+                };
+
+            public:
+                explicit work_stealing_queue(size_type workers)
+                : workers_{std::max(workers, size_type{1})}
+                , locals_{new local_queue[workers_]}
+                , size_{0}, next_{0}
+                {}
+
+                work_stealing_queue(size_type workers, std::queue<TaskT> tasks)
+                : work_stealing_queue(workers)
+                {
+                    auto n = tasks.size();
+                    for(auto i = size_type{0}; !tasks.empty(); ++i)
+                    {
+                        locals_[i * workers_ / n].tasks.push_back(std::move(tasks.front()));
+                        tasks.pop();
+                    }
+                    size_.store(n);
+                }
+
+                work_stealing_queue(const work_stealing_queue&) = delete;
+                auto operator=(const work_stealing_queue&) -> work_stealing_queue& = delete;
+
+                auto get_worker(size_type index) noexcept -> worker
+                {
+                    return worker{this, index % workers_};
+                }
+
+                /* Distributes the tasks round-robin */
+                auto push(TaskT&& t) -> void
+                {
+                    push(next_.fetch_add(1, std::memory_order_relaxed) % workers_, std::move(t));
+                }
+
+                auto push(size_type index, TaskT&& t) -> void
+                {
+                    auto& local = locals_[index];
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{local.mutex};
+                        local.tasks.push_back(std::move(t));
+                    }
+                    size_.fetch_add(1, std::memory_order_release);
+                }
+
+                auto try_pop(size_type index, TaskT& t) -> bool
+                {
+                    if(size_.load(std::memory_order_acquire) == 0)
+                        return false;
+
+                    auto& local = locals_[index];
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{local.mutex};
+                        if(!local.tasks.empty())
+                        {
+                            t = std::move(local.tasks.front());
+                            local.tasks.pop_front();
+                            size_.fetch_sub(1, std::memory_order_relaxed);
+                            return true;
+                        }
+                    }
+
+                    return steal(index, t);
+                }
+
+                auto workers() const noexcept -> size_type
+                {
+                    return workers_;
+                }
+
+                /* Only a snapshot while consumers are running */
+                auto size() const noexcept -> size_type
+                {
+                    return size_.load(std::memory_order_acquire);
+                }
+
+                auto empty() const noexcept -> bool
+                {
+                    return size() == 0;
+                }
+
+            private:
+                // padded to keep the locks of different workers off the same cache line
+                struct local_queue
+                {
+                    std::mutex mutex;
+                    std::deque<TaskT> tasks;
+                    char pad[64];
+                };
+
+                auto steal(size_type thief, TaskT& t) -> bool
+                {
+                    for(auto i = size_type{1}; i < workers_; ++i)
+                    {
+                        auto& victim = locals_[(thief + i) % workers_];
+
+                        // a busy victim is skipped, one of the next rounds finds its tasks
+                        auto&& lock = std::unique_lock<std::mutex>{victim.mutex, std::try_to_lock};
+                        if(!lock.owns_lock() || victim.tasks.empty())
+                            continue;
+
+                        t = std::move(victim.tasks.back());
+                        victim.tasks.pop_back();
+                        size_.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+
+                    // nothing stolen without waiting, look again blocking so that a task is not missed
+                    for(auto i = size_type{1}; i < workers_; ++i)
+                    {
+                        auto& victim = locals_[(thief + i) % workers_];
+                        auto&& lock = std::lock_guard<std::mutex>{victim.mutex};
+                        if(victim.tasks.empty())
+                            continue;
+
+                        t = std::move(victim.tasks.back());
+                        victim.tasks.pop_back();
+                        size_.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+
+                    return false;
+                }
+
+            private:
+                size_type workers_;
+                std::unique_ptr<local_queue[]> locals_;
+                std::atomic<size_type> size_;
+                std::atomic<size_type> next_;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_WORK_STEALING_QUEUE_H_ */
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define BOOST_TEST_MODULE ArenaAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/arena_allocator.h>
+
+BOOST_AUTO_TEST_CASE(arena_bumps_through_one_chunk)
+{
+    auto a = glados::generic::arena{4096};
+    auto alloc = glados::generic::arena_allocator<float, glados::memory_layout::pointer_1D>{a};
+
+    auto p = alloc.allocate(16);
+    auto q = alloc.allocate(16);
+    BOOST_CHECK_EQUAL(q - p, 16);
+    BOOST_CHECK_EQUAL(a.capacity(), 4096u);
+    BOOST_CHECK_EQUAL(a.used() % sizeof(float), 0u);
+
+    // the memory is only reclaimed as a whole
+    alloc.deallocate(q);
+    BOOST_CHECK(alloc.allocate(1) == q + 16);
+}
+
+BOOST_AUTO_TEST_CASE(arena_respects_alignment)
+{
+    auto a = glados::generic::arena{4096};
+    auto bytes = glados::generic::arena_allocator<char, glados::memory_layout::pointer_1D>{a};
+    auto doubles = glados::generic::arena_allocator<double, glados::memory_layout::pointer_1D>{bytes};
+    BOOST_CHECK(bytes == doubles);
+
+    bytes.allocate(3);
+    auto d = doubles.allocate(4);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(arena_reset_reuses_its_chunks)
+{
+    auto a = glados::generic::arena{1024};
+    auto alloc = glados::generic::arena_allocator<int, glados::memory_layout::pointer_2D>{a};
+
+    auto first = std::vector<int*>{};
+    for(auto task = 0; task < 3; ++task)
+    {
+        auto blocks = std::vector<int*>{};
+        for(auto i = 0; i < 10; ++i)
+            blocks.push_back(alloc.allocate(8, 8));
+
+        // later tasks see the same memory and no further chunks
+        if(task == 0)
+            first = blocks;
+        else
+            BOOST_CHECK(blocks == first);
+
+        a.reset();
+        BOOST_CHECK_EQUAL(a.used(), 0u);
+    }
+    BOOST_CHECK_EQUAL(a.capacity(), 3 * 1024u);
+
+    a.release();
+    BOOST_CHECK_EQUAL(a.capacity(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(arena_gives_large_requests_their_own_chunk)
+{
+    auto a = glados::generic::arena{1024};
+    auto alloc = glados::generic::arena_allocator<char, glados::memory_layout::pointer_3D>{a};
+
+    alloc.allocate(10, 10, 5);
+    auto large = alloc.allocate(16, 16, 16);
+    BOOST_CHECK(large != nullptr);
+    BOOST_CHECK_GE(a.capacity(), 1024u + 4096u);
+
+    // the first chunk still serves small requests after a reset
+    a.reset();
+    alloc.allocate(10, 10, 5);
+    BOOST_CHECK_EQUAL(a.used(), 500u);
+}
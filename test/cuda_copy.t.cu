@@ -29,6 +29,7 @@
 #include <glados/cuda/algorithm.h>
 #include <glados/cuda/memory.h>
 #include <glados/cuda/sync_policy.h>
+#include <glados/generic/pitched_allocator.h>
 
 BOOST_AUTO_TEST_CASE(cuda_copy_sync_1d)
 {
@@ -96,6 +97,29 @@ BOOST_AUTO_TEST_CASE(cuda_copy_sync_3d)
     BOOST_CHECK(std::equal(ho, ho + dim, hd));
 }
 
+BOOST_AUTO_TEST_CASE(cuda_copy_sync_pitched_host)
+{
+    constexpr auto szx = 60;
+    constexpr auto szy = 16;
+    constexpr auto szz = 4;
+
+    auto host_orig = glados::generic::make_unique_pitched<int>(szx, szy, szz);
+    auto host_dest = glados::generic::make_unique_pitched<int>(szx, szy, szz);
+    auto dev = glados::cuda::make_unique_device<int>(szx, szy, szz);
+
+    for(auto r = 0; r < szy * szz; ++r)
+    {
+        std::generate(host_orig.row(r), host_orig.row(r) + szx, std::rand);
+        std::fill(host_dest.row(r), host_dest.row(r) + szx, 0);
+    }
+
+    glados::cuda::copy(glados::cuda::sync, dev, host_orig, szx, szy, szz);
+    glados::cuda::copy(glados::cuda::sync, host_dest, dev, szx, szy, szz);
+
+    for(auto r = 0; r < szy * szz; ++r)
+        BOOST_CHECK(std::equal(host_orig.row(r), host_orig.row(r) + szx, host_dest.row(r)));
+}
+
 BOOST_AUTO_TEST_CASE(cuda_copy_async_1d)
 {
     constexpr auto szx = 4096;
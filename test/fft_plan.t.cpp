@@ -0,0 +1,237 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE FFTPlan
+#include <boost/test/unit_test.hpp>
+
+#include <glados/fft/plan.h>
+#include <glados/fft/plan_cache.h>
+
+namespace
+{
+    template <class T>
+    auto random_signal(std::size_t n, unsigned int seed) -> std::vector<std::complex<T>>
+    {
+        auto gen = std::mt19937{seed};
+        auto dist = std::uniform_real_distribution<T>{-1, 1};
+        auto v = std::vector<std::complex<T>>(n);
+        for(auto&& e : v)
+            e = std::complex<T>{dist(gen), dist(gen)};
+        return v;
+    }
+
+    // naive DFT along one dimension of a dense array
+    template <class T>
+    auto dft(const std::vector<std::complex<T>>& in, std::size_t outer, std::size_t len, std::size_t inner, int sign)
+    -> std::vector<std::complex<T>>
+    {
+        const auto pi = std::acos(-1.0);
+        auto out = std::vector<std::complex<T>>(in.size());
+        for(auto o = std::size_t{0}; o < outer; ++o)
+            for(auto i = std::size_t{0}; i < inner; ++i)
+                for(auto k = std::size_t{0}; k < len; ++k)
+                {
+                    auto sum = std::complex<double>{};
+                    for(auto j = std::size_t{0}; j < len; ++j)
+                    {
+                        auto phi = sign * 2.0 * pi * static_cast<double>((j * k) % len) / static_cast<double>(len);
+                        auto x = in[(o * len + j) * inner + i];
+                        sum += std::complex<double>{x.real(), x.imag()} * std::complex<double>{std::cos(phi), std::sin(phi)};
+                    }
+                    out[(o * len + k) * inner + i] = std::complex<T>{static_cast<T>(sum.real()), static_cast<T>(sum.imag())};
+                }
+        return out;
+    }
+
+    template <class T>
+    auto max_error(const std::complex<T>* a, const std::complex<T>* b, std::size_t n) -> double
+    {
+        auto e = 0.0;
+        for(auto i = std::size_t{0}; i < n; ++i)
+            e = std::max(e, static_cast<double>(std::abs(a[i] - b[i])));
+        return e;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(c2c_1d_sizes)
+{
+    for(auto n : {1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 15, 16, 17, 30, 64, 97, 100, 128, 243, 1000})
+    {
+        auto in = random_signal<double>(n, n);
+        auto out = std::vector<std::complex<double>>(n);
+        auto p = glados::fft::plan<glados::fft::type::z2z>{n};
+
+        p.execute(in.data(), out.data(), glados::fft::forward);
+        auto ref = dft(in, 1, n, 1, -1);
+        BOOST_CHECK_MESSAGE(max_error(out.data(), ref.data(), n) < 1e-9 * n, "forward, n = " << n);
+
+        p.execute(in.data(), out.data(), glados::fft::inverse);
+        ref = dft(in, 1, n, 1, 1);
+        BOOST_CHECK_MESSAGE(max_error(out.data(), ref.data(), n) < 1e-9 * n, "inverse, n = " << n);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(c2c_float_in_place)
+{
+    constexpr auto n = 360;
+    auto in = random_signal<float>(n, 1);
+    auto ref = dft(in, 1, n, 1, -1);
+
+    auto p = glados::fft::plan<glados::fft::type::c2c>{n};
+    p.execute(in.data(), in.data(), glados::fft::forward);
+    BOOST_CHECK_LT(max_error(in.data(), ref.data(), n), 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(real_round_trip)
+{
+    for(auto n : {1, 2, 5, 8, 9, 14, 50, 127, 512})
+    {
+        auto c = random_signal<double>(n, 7);
+        auto x = std::vector<double>(n);
+        for(auto i = 0; i < n; ++i)
+        {
+            x[i] = c[i].real();
+            c[i].imag(0);
+        }
+
+        auto spectrum = std::vector<std::complex<double>>(n / 2 + 1);
+        auto r2c = glados::fft::plan<glados::fft::type::d2z>{n};
+        r2c.execute(x.data(), spectrum.data());
+
+        auto ref = dft(c, 1, n, 1, -1);
+        BOOST_CHECK_MESSAGE(max_error(spectrum.data(), ref.data(), n / 2 + 1) < 1e-9 * n, "d2z, n = " << n);
+
+        // unnormalized like cuFFT
+        auto back = std::vector<double>(n);
+        auto c2r = glados::fft::plan<glados::fft::type::z2d>{n};
+        c2r.execute(spectrum.data(), back.data());
+        for(auto i = 0; i < n; ++i)
+            BOOST_REQUIRE_CLOSE_FRACTION(back[i] / n + 10.0, x[i] + 10.0, 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(multi_dimensional)
+{
+    constexpr auto nx = 6;
+    constexpr auto ny = 5;
+    constexpr auto nz = 8;
+
+    auto in = random_signal<double>(nx * ny * nz, 3);
+    auto out = std::vector<std::complex<double>>(in.size());
+    auto p = glados::fft::plan<glados::fft::type::z2z>{nx, ny, nz};
+    p.execute(in.data(), out.data(), glados::fft::forward);
+
+    auto ref = dft(dft(dft(in, nx * ny, nz, 1, -1), nx, ny, nz, -1), 1, nx, ny * nz, -1);
+    BOOST_CHECK_LT(max_error(out.data(), ref.data(), in.size()), 1e-9);
+
+    // 2D real transform: the last dimension holds ny / 2 + 1 values
+    auto x = std::vector<float>(nx * ny);
+    auto c = std::vector<std::complex<float>>(nx * ny);
+    for(auto i = 0; i < nx * ny; ++i)
+    {
+        x[i] = static_cast<float>(in[i].real());
+        c[i] = std::complex<float>{x[i], 0.f};
+    }
+
+    auto spectrum = std::vector<std::complex<float>>(nx * (ny / 2 + 1));
+    auto r2c = glados::fft::plan<glados::fft::type::r2c>{nx, ny};
+    r2c.execute(x.data(), spectrum.data());
+
+    auto full = dft(dft(c, nx, ny, 1, -1), 1, nx, ny, -1);
+    for(auto i = 0; i < nx; ++i)
+        BOOST_CHECK_LT(max_error(&spectrum[i * (ny / 2 + 1)], &full[i * ny], ny / 2 + 1), 1e-4);
+
+    auto back = std::vector<float>(nx * ny);
+    auto c2r = glados::fft::plan<glados::fft::type::c2r>{nx, ny};
+    c2r.execute(spectrum.data(), back.data());
+    for(auto i = 0; i < nx * ny; ++i)
+        BOOST_CHECK_SMALL(back[i] / (nx * ny) - x[i], 1e-5f);
+}
+
+BOOST_AUTO_TEST_CASE(plan_many_strided)
+{
+    // 4 transforms of 10 elements, interleaved in the input, padded rows in the output
+    constexpr auto n = 10;
+    constexpr auto batch = 4;
+    int sizes[] = {n};
+    int inembed[] = {n};
+    int onembed[] = {16};
+
+    auto in = random_signal<double>(n * batch, 5);
+    auto out = std::vector<std::complex<double>>(16 * batch);
+    auto p = glados::fft::plan<glados::fft::type::z2z>{1, sizes, inembed, batch, 1, onembed, 1, 16, batch};
+    p.execute(in.data(), out.data(), glados::fft::forward);
+
+    for(auto b = 0; b < batch; ++b)
+    {
+        auto line = std::vector<std::complex<double>>(n);
+        for(auto i = 0; i < n; ++i)
+            line[i] = in[i * batch + b];
+
+        auto ref = dft(line, 1, n, 1, -1);
+        BOOST_CHECK_LT(max_error(&out[b * 16], ref.data(), n), 1e-9);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(plan_errors)
+{
+    using plan_type = glados::fft::plan<glados::fft::type::c2c>;
+    BOOST_CHECK_THROW(plan_type{0}, std::invalid_argument);
+
+    auto in = std::vector<std::complex<float>>(4);
+    auto empty = plan_type{};
+    BOOST_CHECK_THROW(empty.execute(in.data(), in.data(), glados::fft::forward), std::invalid_argument);
+
+    auto p = plan_type{4};
+    BOOST_CHECK_THROW(p.execute(in.data(), in.data(), 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(cache_reuses_plans)
+{
+    using plan_type = glados::fft::plan<glados::fft::type::r2c>;
+    auto& cache = glados::fft::plan_cache<plan_type>::instance();
+    cache.clear();
+
+    auto a = cache.get(1024);
+    auto b = cache.get(1024);
+    auto c = cache.get(32, 32);
+    BOOST_CHECK(a == b);
+    BOOST_CHECK(a != c);
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+
+    // strides and distances only count with an embedding
+    int n[] = {1024};
+    int embed[] = {1024};
+    BOOST_CHECK(cache.get(1, n, nullptr, 3, 7, nullptr, 5, 9, 1) == a);
+    BOOST_CHECK(cache.get(1, n, embed, 1, 1024, embed, 1, 513, 1) != a);
+    BOOST_CHECK(cache.get(1, n, embed, 1, 1024, embed, 1, 513, 2) != a);
+    BOOST_CHECK_EQUAL(cache.size(), 4u);
+
+    // the other types have caches of their own
+    BOOST_CHECK_EQUAL(glados::fft::plan_cache<glados::fft::plan<glados::fft::type::c2r>>::instance().size(), 0u);
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE FFTRows
+#include <boost/test/unit_test.hpp>
+
+#include <glados/bits/pitched_ptr.h>
+#include <glados/fft/plan.h>
+#include <glados/fft/rows.h>
+#include <glados/generic/pitched_allocator.h>
+
+BOOST_AUTO_TEST_CASE(row_batch_from_pitch)
+{
+    constexpr auto x = std::size_t{100};
+    constexpr auto y = std::size_t{37};
+
+    auto in = glados::generic::make_unique_pitched<float>(x, y);
+    auto out = glados::generic::make_unique_pitched<std::complex<float>>(x / 2 + 1, y);
+
+    auto b = glados::fft::make_row_batch(in, out, x, y);
+    BOOST_CHECK_EQUAL(b.n[0], 100);
+    BOOST_CHECK_EQUAL(b.batch, 37);
+    BOOST_CHECK_EQUAL(b.istride, 1);
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(b.idist), in.pitch() / sizeof(float));
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(b.odist), out.pitch() / sizeof(std::complex<float>));
+    BOOST_CHECK_EQUAL(b.inembed[0], b.idist);
+
+    // dense rows
+    auto dense = std::unique_ptr<std::complex<float>[]>{new std::complex<float>[(x / 2 + 1) * y * 3]};
+    auto back = std::unique_ptr<float[]>{new float[x * y * 3]};
+    auto c = glados::fft::make_row_batch(dense, back, x, y, 3);
+    BOOST_CHECK_EQUAL(c.idist, 51);
+    BOOST_CHECK_EQUAL(c.odist, 100);
+    BOOST_CHECK_EQUAL(c.batch, 111);
+
+    // a pitch which doesn't hold whole elements or rows
+    auto odd = glados::pitched_ptr<float>{in.get(), 6};
+    BOOST_CHECK_THROW(glados::fft::make_row_batch(odd, out, x, y), std::invalid_argument);
+    auto narrow = glados::pitched_ptr<float>{in.get(), 64};
+    BOOST_CHECK_THROW(glados::fft::make_row_batch(narrow, out, x, y), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(transform_rows_matches_single_rows)
+{
+    constexpr auto x = std::size_t{100};
+    constexpr auto y = std::size_t{12};
+    constexpr auto z = std::size_t{3};
+
+    auto gen = std::mt19937{42};
+    auto dist = std::uniform_real_distribution<float>{-1.f, 1.f};
+
+    auto in = glados::generic::make_unique_pitched<float>(x, y, z);
+    for(auto r = std::size_t{0}; r < y * z; ++r)
+        for(auto i = std::size_t{0}; i < x; ++i)
+            in.row(r)[i] = dist(gen);
+
+    auto out = glados::generic::make_unique_pitched<std::complex<float>>(x / 2 + 1, y, z);
+    glados::fft::transform_rows(in, out, x, y, z);
+
+    auto single = glados::fft::plan<glados::fft::type::r2c>{static_cast<int>(x)};
+    auto ref = std::vector<std::complex<float>>(x / 2 + 1);
+    for(auto r = std::size_t{0}; r < y * z; ++r)
+    {
+        single.execute(in.row(r), ref.data());
+        for(auto k = std::size_t{0}; k < x / 2 + 1; ++k)
+            BOOST_REQUIRE_SMALL(std::abs(out.row(r)[k] - ref[k]), 1e-4f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ramp_filter_projection)
+{
+    // a constant projection keeps only its DC component, which the ramp removes
+    constexpr auto width = std::size_t{64};
+    constexpr auto rows = std::size_t{20};
+    constexpr auto n = 2 * width;
+
+    auto proj = glados::generic::make_unique_pitched<float>(n, rows);
+    for(auto r = std::size_t{0}; r < rows; ++r)
+        for(auto i = std::size_t{0}; i < n; ++i)
+            proj.row(r)[i] = (i < width) ? 1.f : 0.f;
+
+    auto spectrum = glados::generic::make_unique_pitched<std::complex<float>>(n / 2 + 1, rows);
+    glados::fft::transform_rows(proj, spectrum, n, rows);
+    for(auto r = std::size_t{0}; r < rows; ++r)
+        for(auto k = std::size_t{0}; k < n / 2 + 1; ++k)
+            spectrum.row(r)[k] *= static_cast<float>(k) / static_cast<float>(n);
+
+    auto filtered = glados::generic::make_unique_pitched<float>(n, rows);
+    glados::fft::transform_rows(spectrum, filtered, n, rows);
+
+    auto sum = 0.f;
+    for(auto i = std::size_t{0}; i < n; ++i)
+        sum += filtered.row(rows - 1)[i];
+    BOOST_CHECK_SMALL(sum, 1e-3f);
+    BOOST_CHECK_GT(filtered.row(0)[0], 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(transform_rows_c2c)
+{
+    constexpr auto x = std::size_t{30};
+    constexpr auto y = std::size_t{7};
+
+    auto data = glados::generic::make_unique_pitched<std::complex<double>>(x, y);
+    for(auto r = std::size_t{0}; r < y; ++r)
+        for(auto i = std::size_t{0}; i < x; ++i)
+            data.row(r)[i] = std::complex<double>{static_cast<double>(r), static_cast<double>(i)};
+
+    // in place there and back
+    glados::fft::transform_rows(data, data, glados::fft::forward, x, y);
+    glados::fft::transform_rows(data, data, glados::fft::inverse, x, y);
+    for(auto r = std::size_t{0}; r < y; ++r)
+        for(auto i = std::size_t{0}; i < x; ++i)
+            BOOST_REQUIRE_SMALL(std::abs(data.row(r)[i] / static_cast<double>(x) - std::complex<double>{static_cast<double>(r), static_cast<double>(i)}), 1e-9);
+}
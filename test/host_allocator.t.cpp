@@ -0,0 +1,107 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define BOOST_TEST_MODULE HostAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/aligned_allocator.h>
+#include <glados/generic/huge_page_allocator.h>
+#include <glados/memory.h>
+
+namespace
+{
+    auto offset(const void* p, std::size_t alignment) -> std::size_t
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(aligned_allocator_aligns_every_layout)
+{
+    auto a1 = glados::generic::aligned_allocator<float, glados::memory_layout::pointer_1D>{};
+    auto a2 = glados::generic::aligned_allocator<char, glados::memory_layout::pointer_2D, 128>{};
+    auto a3 = glados::generic::aligned_allocator<double, glados::memory_layout::pointer_3D, 4096>{};
+
+    for(auto n = std::size_t{1}; n < 100; n += 7)
+    {
+        auto p1 = a1.allocate(n);
+        auto p2 = a2.allocate(n, 3);
+        auto p3 = a3.allocate(n, 2, 2);
+        BOOST_CHECK_EQUAL(offset(p1, 64), 0u);
+        BOOST_CHECK_EQUAL(offset(p2, 128), 0u);
+        BOOST_CHECK_EQUAL(offset(p3, 4096), 0u);
+        p1[n - 1] = 1.f;
+        a1.deallocate(p1);
+        a2.deallocate(p2);
+        a3.deallocate(p3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_allocator_maps_large_blocks_at_huge_page_boundaries)
+{
+    using alloc_type = glados::generic::huge_page_allocator<float, glados::memory_layout::pointer_3D>;
+    auto alloc = alloc_type{};
+
+    auto small = alloc.allocate(4, 4, 4);
+    BOOST_CHECK_EQUAL(offset(small, 4096), 0u);
+    small[63] = 1.f;
+
+    auto large = alloc.allocate(128, 128, 64);
+    BOOST_CHECK_EQUAL(offset(large, 2u << 20), 0u);
+    large[128 * 128 * 64 - 1] = 2.f;
+
+    // the allocator knows the length of every mapping, so pools may return blocks without their shape
+    alloc.deallocate(small);
+    alloc.deallocate(large, 128, 128, 64);
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_allocator_binds_to_a_numa_node)
+{
+    auto alloc = glados::generic::huge_page_allocator<int, glados::memory_layout::pointer_1D, 0>{};
+    auto p = alloc.allocate(4096);
+    p[0] = 1;
+
+    auto node = -1;
+    auto ret = syscall(SYS_get_mempolicy, &node, nullptr, 0ul, p, MPOL_F_NODE | MPOL_F_ADDR);
+    if(ret == 0)
+        BOOST_CHECK_EQUAL(node, 0);
+
+    alloc.deallocate(p);
+}
+
+BOOST_AUTO_TEST_CASE(host_allocators_back_a_pool)
+{
+    using internal = glados::generic::huge_page_allocator<float, glados::memory_layout::pointer_2D>;
+    auto pool = glados::pool_allocator<float, glados::memory_layout::pointer_2D, internal>{};
+
+    auto p = pool.allocate_smart(256, 256);
+    BOOST_CHECK_EQUAL(offset(p.get(), 64), 0u);
+    p.reset();
+    pool.release();
+}
@@ -0,0 +1,124 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE HostLaunch
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/coordinates.h>
+#include <glados/generic/launch.h>
+#include <glados/generic/thread_pool.h>
+
+BOOST_AUTO_TEST_CASE(launch_1d)
+{
+    glados::generic::thread_pool pool{3};
+
+    constexpr auto szx = std::size_t{100003};
+    auto v = std::vector<int>(szx, 0);
+    glados::generic::launch(pool, szx, [&v](std::size_t x) { v[x] += static_cast<int>(x); });
+
+    for(auto x = std::size_t{0}; x < szx; ++x)
+        BOOST_REQUIRE_EQUAL(v[x], static_cast<int>(x));
+}
+
+BOOST_AUTO_TEST_CASE(launch_2d_odd_block)
+{
+    glados::generic::thread_pool pool{2};
+
+    constexpr auto szx = std::size_t{301};
+    constexpr auto szy = std::size_t{77};
+    auto v = std::vector<int>(szx * szy, 0);
+    glados::generic::launch(pool, szx, szy, [&v](std::size_t x, std::size_t y) {
+        ++v[y * szx + x];
+    }, glados::generic::block_shape{7, 5});
+
+    for(auto&& e : v)
+        BOOST_REQUIRE_EQUAL(e, 1);
+}
+
+BOOST_AUTO_TEST_CASE(launch_3d_coordinates)
+{
+    glados::generic::thread_pool pool{2};
+
+    constexpr auto szx = std::size_t{70};
+    constexpr auto szy = std::size_t{20};
+    constexpr auto szz = std::size_t{9};
+    auto v = std::vector<unsigned int>(szx * szy * szz, 0u);
+
+    // written like a CUDA kernel
+    auto kernel = [&v]() {
+        auto x = glados::generic::coord_x();
+        auto y = glados::generic::coord_y();
+        auto z = glados::generic::coord_z();
+        v[(z * szy + y) * szx + x] = z * 10000u + y * 100u + x;
+    };
+    glados::generic::launch(pool, szx, szy, szz, kernel);
+
+    for(auto z = 0u; z < szz; ++z)
+        for(auto y = 0u; y < szy; ++y)
+            for(auto x = 0u; x < szx; ++x)
+                BOOST_REQUIRE_EQUAL(v[(z * szy + y) * szx + x], z * 10000u + y * 100u + x);
+}
+
+BOOST_AUTO_TEST_CASE(launch_empty)
+{
+    glados::generic::thread_pool pool{1};
+    auto calls = 0;
+    glados::generic::launch(pool, 0, 10, [&calls](std::size_t, std::size_t) { ++calls; });
+    BOOST_CHECK_EQUAL(calls, 0);
+}
+
+BOOST_AUTO_TEST_CASE(launch_error)
+{
+    glados::generic::thread_pool pool{2};
+
+    std::atomic<int> calls{0};
+    auto kernel = [&calls](std::size_t x) {
+        ++calls;
+        if(x == 5)
+            throw std::runtime_error{"kernel failed"};
+    };
+    BOOST_CHECK_THROW(glados::generic::launch(pool, 1 << 20, kernel, glados::generic::block_shape{64}), std::runtime_error);
+    BOOST_CHECK(calls < (1 << 20));
+
+    // the pool is still usable
+    std::atomic<std::size_t> sum{0};
+    glados::generic::launch(pool, 1000, [&sum](std::size_t x) { sum += x; });
+    BOOST_CHECK_EQUAL(sum.load(), 999u * 1000u / 2u);
+}
+
+BOOST_AUTO_TEST_CASE(launch_from_pool_thread)
+{
+    // the only pool thread launches itself, the caller works through the tiles alone
+    glados::generic::thread_pool pool{1};
+
+    std::atomic<std::size_t> count{0};
+    auto done = pool.submit([&pool, &count]() {
+        glados::generic::launch(pool, 512, 512, [&count](std::size_t, std::size_t) { ++count; });
+    });
+    done.get();
+    BOOST_CHECK_EQUAL(count.load(), 512u * 512u);
+}
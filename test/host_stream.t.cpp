@@ -0,0 +1,152 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE HostStream
+#include <boost/test/unit_test.hpp>
+
+#include <glados/cuda/algorithm.h>
+#include <glados/generic/pitched_allocator.h>
+#include <glados/generic/stream.h>
+#include <glados/generic/sync_policy.h>
+#include <glados/generic/thread_pool.h>
+
+BOOST_AUTO_TEST_CASE(stream_order)
+{
+    glados::generic::thread_pool pool{4};
+    glados::generic::stream s{pool};
+
+    auto order = std::vector<int>{};
+    for(auto i = 0; i < 1000; ++i)
+        s.enqueue([&order, i]() { order.push_back(i); });
+
+    s.synchronize();
+    BOOST_CHECK(s.query());
+    BOOST_REQUIRE_EQUAL(order.size(), 1000u);
+    for(auto i = 0; i < 1000; ++i)
+        BOOST_CHECK_EQUAL(order[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(stream_error)
+{
+    glados::generic::thread_pool pool{2};
+    glados::generic::stream s{pool};
+
+    auto ran = false;
+    s.enqueue([]() { throw std::runtime_error{"first"}; });
+    s.enqueue([]() { throw std::logic_error{"second"}; });
+    s.enqueue([&ran]() { ran = true; });
+
+    BOOST_CHECK_THROW(s.synchronize(), std::runtime_error);
+    BOOST_CHECK(ran);
+    BOOST_CHECK_NO_THROW(s.synchronize());
+}
+
+BOOST_AUTO_TEST_CASE(event_between_streams)
+{
+    glados::generic::thread_pool pool{2};
+    glados::generic::stream producer{pool};
+    glados::generic::stream consumer{pool};
+
+    auto e = glados::generic::event{};
+    BOOST_CHECK(e.query()); // never recorded
+
+    std::atomic<int> value{0};
+    auto seen = -1;
+
+    // keep the producer busy until the consumer has been set up
+    auto release = std::make_shared<glados::generic::detail::event_state>();
+    producer.enqueue([release]() { release->wait(); });
+    producer.enqueue([&value]() { value = 42; });
+    e.record(producer);
+    BOOST_CHECK(!e.query());
+
+    consumer.wait(e);
+    consumer.enqueue([&value, &seen]() { seen = value; });
+
+    release->complete();
+    consumer.synchronize();
+    BOOST_CHECK_EQUAL(seen, 42);
+    BOOST_CHECK(e.query());
+    e.synchronize();
+}
+
+BOOST_AUTO_TEST_CASE(async_copy_fill)
+{
+    glados::generic::thread_pool pool{2};
+    glados::generic::stream s{pool};
+
+    constexpr auto szx = std::size_t{1000};
+    constexpr auto szy = std::size_t{100};
+
+    auto src = std::unique_ptr<int[]>{new int[szx * szy]};
+    std::iota(src.get(), src.get() + szx * szy, 0);
+    auto dst = std::unique_ptr<int[]>{new int[szx * szy]};
+
+    auto pitched = glados::generic::make_unique_pitched<int>(szx, szy);
+    {
+        // the owner may be moved away, the memory has to stay
+        auto moved = std::move(src);
+        glados::cuda::copy(glados::generic::async, pitched, moved, s, szx, szy);
+        src = std::move(moved);
+    }
+    glados::cuda::fill(glados::generic::async, dst, 0, s, szx * szy);
+    glados::cuda::copy(glados::generic::async, dst, pitched, s, szx, szy);
+    s.synchronize();
+
+    for(auto i = std::size_t{0}; i < szx * szy; ++i)
+        BOOST_REQUIRE_EQUAL(dst[i], static_cast<int>(i));
+
+    auto vol = glados::generic::make_unique_pitched<int>(szx, szy, 3);
+    glados::cuda::fill(glados::generic::async, vol, 0xff, s, szx, szy, 3);
+    s.synchronize();
+    for(auto z = std::size_t{0}; z < 3; ++z)
+        for(auto y = std::size_t{0}; y < szy; ++y)
+            BOOST_REQUIRE_EQUAL(vol.row(z * szy + y)[szx - 1], -1);
+}
+
+BOOST_AUTO_TEST_CASE(async_overlaps_caller)
+{
+    glados::generic::thread_pool pool{1};
+    glados::generic::stream s{pool};
+
+    auto release = std::make_shared<glados::generic::detail::event_state>();
+    s.enqueue([release]() { release->wait(); });
+
+    constexpr auto szx = std::size_t{4096};
+    auto src = std::unique_ptr<char[]>{new char[szx]};
+    auto dst = std::unique_ptr<char[]>{new char[szx]};
+    glados::cuda::fill(glados::generic::async, src, 7, s, szx);
+    glados::cuda::copy(glados::generic::async, dst, src, s, szx);
+
+    // nothing ran yet, the calls returned immediately
+    BOOST_CHECK(!s.query());
+    release->complete();
+    s.synchronize();
+    BOOST_CHECK_EQUAL(dst[szx - 1], 7);
+}
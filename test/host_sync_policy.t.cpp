@@ -0,0 +1,139 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+
+#define BOOST_TEST_MODULE HostSyncPolicy
+#include <boost/test/unit_test.hpp>
+
+#include <glados/cuda/algorithm.h>
+#include <glados/generic/pitched_allocator.h>
+#include <glados/generic/sync_policy.h>
+#include <glados/generic/thread_pool.h>
+
+BOOST_AUTO_TEST_CASE(host_copy_1d)
+{
+    // large enough to use several threads and streaming stores
+    constexpr auto szx = std::size_t{5} << 20;
+
+    auto src = std::unique_ptr<int[]>{new int[szx]};
+    auto dst = std::unique_ptr<int[]>{new int[szx]};
+    std::iota(src.get(), src.get() + szx, 0);
+
+    glados::cuda::copy(glados::generic::sync_policy{4}, dst, src, szx);
+    BOOST_CHECK(std::equal(src.get(), src.get() + szx, dst.get()));
+}
+
+BOOST_AUTO_TEST_CASE(host_copy_runs_on_a_given_pool)
+{
+    constexpr auto szx = std::size_t{5} << 20;
+
+    auto src = std::unique_ptr<int[]>{new int[szx]};
+    auto dst = std::unique_ptr<int[]>{new int[szx]};
+    std::iota(src.get(), src.get() + szx, 0);
+
+    glados::generic::thread_pool pool{3};
+    auto policy = glados::generic::sync_policy{pool};
+    glados::cuda::copy(policy, dst, src, szx);
+    BOOST_CHECK(std::equal(src.get(), src.get() + szx, dst.get()));
+
+    // from a thread of the same pool, which must not wait for its own helpers
+    auto done = pool.submit([&]() { glados::cuda::fill(policy, dst, 0, szx); });
+    done.get();
+    BOOST_CHECK(std::all_of(dst.get(), dst.get() + szx, [](int i) { return i == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(host_copy_2d_between_pitched_and_dense)
+{
+    constexpr auto szx = 100;
+    constexpr auto szy = 30;
+
+    auto dense = std::unique_ptr<float[]>{new float[szx * szy]};
+    auto back = std::unique_ptr<float[]>{new float[szx * szy]};
+    auto pitched = glados::generic::make_unique_pitched<float>(szx, szy);
+    std::generate(dense.get(), dense.get() + szx * szy, std::rand);
+    std::fill(back.get(), back.get() + szx * szy, 0.f);
+
+    glados::cuda::copy(glados::generic::sync, pitched, dense, szx, szy);
+    for(auto r = 0; r < szy; ++r)
+        BOOST_CHECK(std::equal(pitched.row(r), pitched.row(r) + szx, dense.get() + r * szx));
+
+    glados::cuda::copy(glados::generic::sync, back, pitched, szx, szy);
+    BOOST_CHECK(std::equal(dense.get(), dense.get() + szx * szy, back.get()));
+}
+
+BOOST_AUTO_TEST_CASE(host_copy_3d_honours_offsets)
+{
+    constexpr auto szx = 4;
+    constexpr auto szy = 4;
+    constexpr auto szz = 3;
+
+    // as with cudaMemcpy3D, dense memory is as wide as the copy and its slices have szy rows
+    auto src = std::unique_ptr<int[]>{new int[szx * szy * (szz + 2)]};
+    auto dst = glados::generic::make_unique_pitched<int>(8, szy, szz + 1);
+    std::iota(src.get(), src.get() + szx * szy * (szz + 2), 0);
+    for(auto r = 0; r < szy * (szz + 1); ++r)
+        std::fill(dst.row(r), dst.row(r) + 8, -1);
+
+    // skips the first two slices of src and writes to x = 3 of the second slice of dst
+    auto policy = glados::generic::sync_policy{2};
+    glados::cuda::copy(policy, dst, src, szx, szy, szz, 3, 0, 1, 0, 0, 2);
+
+    for(auto z = 0; z < szz; ++z)
+    {
+        for(auto y = 0; y < szy; ++y)
+        {
+            auto row = dst.row(static_cast<std::size_t>((z + 1) * szy + y));
+            auto first = src.get() + ((z + 2) * szy + y) * szx;
+            BOOST_CHECK(std::equal(first, first + szx, row + 3));
+            BOOST_CHECK_EQUAL(row[2], -1);
+            BOOST_CHECK_EQUAL(row[7], -1);
+        }
+    }
+    BOOST_CHECK(std::all_of(dst.row(0), dst.row(0) + 8, [](int i) { return i == -1; }));
+}
+
+BOOST_AUTO_TEST_CASE(host_fill_sets_bytes_and_skips_padding)
+{
+    constexpr auto szx = 10;
+    constexpr auto szy = 4;
+    constexpr auto szz = 2;
+
+    auto p = glados::generic::make_unique_pitched<unsigned char>(szx, szy, szz);
+    auto bytes = reinterpret_cast<unsigned char*>(p.get());
+    std::fill(bytes, bytes + p.pitch() * szy * szz, 0);
+
+    glados::cuda::fill(glados::generic::sync, p, 0x7f, szx, szy, szz);
+    for(auto r = 0; r < szy * szz; ++r)
+    {
+        BOOST_CHECK(std::all_of(p.row(r), p.row(r) + szx, [](unsigned char c) { return c == 0x7f; }));
+        BOOST_CHECK_EQUAL(p.row(r)[szx], 0);
+    }
+
+    auto q = std::unique_ptr<int[]>{new int[16]};
+    glados::cuda::fill(glados::generic::sync, q, 0, 16);
+    BOOST_CHECK(std::all_of(q.get(), q.get() + 16, [](int i) { return i == 0; }));
+}
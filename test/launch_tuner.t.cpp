@@ -0,0 +1,194 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE LaunchTuner
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/launch.h>
+#include <glados/generic/launch_tuner.h>
+#include <glados/generic/thread_pool.h>
+
+namespace
+{
+    auto is_candidate(const glados::generic::block_shape& b, const std::vector<glados::generic::block_shape>& cs) -> bool
+    {
+        for(auto&& c : cs)
+        {
+            if(c.x == b.x && c.y == b.y && c.z == b.z)
+                return true;
+        }
+        return false;
+    }
+
+    // the tilings the candidates give on an input of w x h x d
+    auto clamped(const std::vector<glados::generic::block_shape>& cs, std::size_t w, std::size_t h, std::size_t d)
+        -> std::vector<glados::generic::block_shape>
+    {
+        auto ret = std::vector<glados::generic::block_shape>{};
+        for(auto&& c : cs)
+            ret.emplace_back(std::min(c.x, w), std::min(c.y, h), std::min(c.z, d));
+        return ret;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tuner_tunes_once)
+{
+    glados::generic::thread_pool pool{2};
+    glados::generic::launch_tuner tuner;
+
+    constexpr auto szx = std::size_t{2048};
+    constexpr auto szy = std::size_t{64};
+    auto out = std::vector<float>(szx * szy, 0.f);
+
+    std::atomic<std::size_t> calls{0};
+    auto kernel = [&](std::size_t x, std::size_t y) {
+        out[y * szx + x] = static_cast<float>(x + y);
+        ++calls;
+    };
+
+    auto b = glados::generic::block_shape{1};
+    BOOST_CHECK(!tuner.try_get("ramp", b));
+
+    tuner.launch(pool, "ramp", szx, szy, kernel);
+    BOOST_REQUIRE(tuner.try_get("ramp", b));
+    auto candidates = glados::generic::launch_tuner::candidates_2d();
+    auto tilings = clamped(candidates, szx, szy, 1);
+    BOOST_CHECK(is_candidate(b, candidates));
+    BOOST_CHECK(is_candidate(glados::generic::block_shape{std::min(b.x, szx), std::min(b.y, szy), b.z}, tilings));
+
+    // one warm-up run plus two trials per distinct tiling, {4096, 1} is clamped onto {2048, 1}
+    auto distinct = std::size_t{0};
+    for(auto i = std::size_t{0}; i < tilings.size(); ++i)
+        distinct += is_candidate(tilings[i], {std::begin(tilings), std::begin(tilings) + i}) ? 0 : 1;
+    BOOST_CHECK_EQUAL(calls.load(), (1 + 2 * distinct) * szx * szy);
+
+    calls = 0;
+    tuner.launch(pool, "ramp", szx, szy, kernel);
+    BOOST_CHECK_EQUAL(calls.load(), szx * szy);
+
+    for(auto y = std::size_t{0}; y < szy; ++y)
+        for(auto x = std::size_t{0}; x < szx; ++x)
+            BOOST_REQUIRE_EQUAL(out[y * szx + x], static_cast<float>(x + y));
+}
+
+BOOST_AUTO_TEST_CASE(tuner_clamps_candidates)
+{
+    glados::generic::thread_pool pool{1};
+    glados::generic::launch_tuner tuner;
+
+    // every candidate collapses onto the whole input, it is run once for warm-up and twice timed
+    auto calls = std::size_t{0};
+    tuner.launch(pool, "tiny", 10, [&calls](std::size_t) { ++calls; });
+    BOOST_CHECK_EQUAL(calls, 30u);
+
+    // the first candidate is kept unclamped, a larger input is not cut into tiles of 10
+    auto b = glados::generic::block_shape{1};
+    BOOST_REQUIRE(tuner.try_get("tiny", b));
+    BOOST_CHECK_EQUAL(b.x, glados::generic::launch_tuner::candidates_1d().front().x);
+
+    calls = 0;
+    tuner.launch(pool, "tiny", 1000, [&calls](std::size_t) { ++calls; });
+    BOOST_CHECK_EQUAL(calls, 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(tuner_takes_any_launcher)
+{
+    glados::generic::launch_tuner tuner;
+    auto candidates = std::vector<glados::generic::block_shape>{glados::generic::block_shape{16, 16, 2},
+                                                                glados::generic::block_shape{32, 8, 1}};
+
+    // a launcher which is only fast with {32, 8, 1}
+    auto seen = std::vector<glados::generic::block_shape>{};
+    auto launcher = [&seen](glados::generic::block_shape b) {
+        seen.push_back(b);
+        if(b.x != 32)
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    };
+
+    tuner.launch("device kernel", 512, 512, 64, candidates, launcher);
+    BOOST_CHECK_EQUAL(seen.size(), 5u);
+
+    auto b = glados::generic::block_shape{1};
+    BOOST_REQUIRE(tuner.try_get("device kernel", b));
+    BOOST_CHECK_EQUAL(b.x, 32u);
+    BOOST_CHECK_EQUAL(b.y, 8u);
+    BOOST_CHECK_EQUAL(b.z, 1u);
+
+    seen.clear();
+    tuner.launch("device kernel", 512, 512, 64, candidates, launcher);
+    BOOST_REQUIRE_EQUAL(seen.size(), 1u);
+    BOOST_CHECK_EQUAL(seen.front().x, 32u);
+
+    BOOST_CHECK_THROW(tuner.launch("no shapes", 8, 8, 8, {}, launcher), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(tuner_persists)
+{
+    auto path = std::string{"launch_tuner.t.txt"};
+    {
+        glados::generic::launch_tuner tuner{path};
+        tuner.set("box filter", glados::generic::block_shape{64, 8, 8});
+        tuner.set("ramp", glados::generic::block_shape{256, 16});
+        tuner.save();
+    }
+
+    glados::generic::launch_tuner tuner{path};
+    std::remove(path.c_str());
+
+    auto b = glados::generic::block_shape{1};
+    BOOST_REQUIRE(tuner.try_get("box filter", b));
+    BOOST_CHECK_EQUAL(b.x, 64u);
+    BOOST_CHECK_EQUAL(b.y, 8u);
+    BOOST_CHECK_EQUAL(b.z, 8u);
+
+    // the stored shape is used without trials
+    glados::generic::thread_pool pool{1};
+    auto calls = std::size_t{0};
+    tuner.launch(pool, "ramp", 300, 20, [&calls](std::size_t, std::size_t) { ++calls; });
+    BOOST_CHECK_EQUAL(calls, 300u * 20u);
+}
+
+BOOST_AUTO_TEST_CASE(tuner_skips_bad_lines)
+{
+    glados::generic::launch_tuner tuner;
+    auto is = std::istringstream{"16 16 4 good\nnot a shape\n32 8\n1 2 3\n"};
+    tuner.read(is);
+
+    auto b = glados::generic::block_shape{1};
+    BOOST_CHECK(tuner.try_get("good", b));
+    BOOST_CHECK_EQUAL(b.z, 4u);
+
+    auto os = std::ostringstream{};
+    tuner.write(os);
+    BOOST_CHECK_EQUAL(os.str(), "16 16 4 good\n");
+}
@@ -0,0 +1,1041 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE Pipeline
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/thread_pool.h>
+#include <glados/pipeline/pipeline.h>
+
+namespace
+{
+    constexpr auto item_count = 10000;
+
+    class source
+    {
+        public:
+            using input_type = void;
+            using output_type = int;
+
+            source() = default;
+            source(int count) : count_{count} {}
+
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            // a negative count emits until the pipeline is shut down
+            auto run() -> void
+            {
+                for(auto i = 0; (count_ < 0) || (i < count_); ++i)
+                    output_(i);
+            }
+
+        private:
+            int count_ = item_count;
+            std::function<void(output_type)> output_;
+    };
+
+    class doubler
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            doubler() = default;
+            doubler(int count) : count_{count} {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+            auto assign_task(int) -> void {}
+
+            // a negative count doubles until the end of the stream
+            auto run() -> void
+            {
+                for(auto i = 0; (count_ < 0) || (i < count_); ++i)
+                    output_(input_() * 2);
+            }
+
+        private:
+            int count_ = -1;
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    // drops odd inputs and emits even ones twice
+    class replica
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto v = input_();
+                    if(v % 8 == 0)
+                        std::this_thread::yield();
+
+                    if(v % 2 == 0)
+                    {
+                        output_(v);
+                        output_(v);
+                    }
+                }
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    // forwards its inputs and, once they have ended, how many it has seen as a negative number
+    class tally
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto run() -> void
+            {
+                auto seen = 0;
+                try
+                {
+                    while(true)
+                    {
+                        output_(input_());
+                        ++seen;
+                    }
+                }
+                catch(const glados::pipeline::end_of_stream&)
+                {
+                    output_(-seen);
+                    throw;
+                }
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    struct thread_log
+    {
+        std::mutex mutex;
+        std::set<std::thread::id> ids;
+
+        auto add() -> void
+        {
+            auto&& lock = std::lock_guard<std::mutex>{mutex};
+            ids.insert(std::this_thread::get_id());
+        }
+    };
+
+    // forwards its inputs and notes the thread it runs on
+    class logged
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            logged(thread_log* log) : log_{log} {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto run() -> void
+            {
+                log_->add();
+                while(true)
+                    output_(input_());
+            }
+
+        private:
+            thread_log* log_;
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    struct stall
+    {
+        std::atomic<bool> released{false};
+        std::atomic<int> emitted{0};
+    };
+
+    // holds on to input 0 until released, forwards every other input at once
+    class stalling
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            stalling(stall* s) : stall_{s} {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto v = input_();
+                    while((v == 0) && !stall_->released.load())
+                        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+                    output_(v);
+                    ++stall_->emitted;
+                }
+            }
+
+        private:
+            stall* stall_;
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    class sink
+    {
+        public:
+            using input_type = int;
+            using output_type = void;
+
+            sink(std::vector<int>& results) : results_(results) {}
+            sink(std::vector<int>& results, int count) : results_(results), count_{count} {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+
+            // a negative count collects until the end of the stream
+            auto run() -> void
+            {
+                for(auto i = 0; (count_ < 0) || (i < count_); ++i)
+                    results_.push_back(input_());
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::vector<int>& results_;
+            int count_ = -1;
+    };
+
+    // records how far the first stage runs ahead of the last one
+    struct task_progress
+    {
+        std::atomic<int> started{0};
+        std::atomic<int> finished{0};
+        std::atomic<int> max_ahead{0};
+    };
+
+    // emits as many items as the task says
+    class task_source
+    {
+        public:
+            using input_type = void;
+            using output_type = int;
+
+            task_source() = default;
+            task_source(task_progress* progress) : progress_{progress} {}
+
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto assign_task(int task) -> void
+            {
+                count_ = task;
+                if(progress_ == nullptr)
+                    return;
+
+                auto ahead = ++progress_->started - progress_->finished.load();
+                auto max = progress_->max_ahead.load();
+                while((ahead > max) && !progress_->max_ahead.compare_exchange_weak(max, ahead)) {}
+            }
+
+            auto run() -> void
+            {
+                for(auto i = 0; i < count_; ++i)
+                    output_(i);
+            }
+
+        private:
+            int count_ = 0;
+            task_progress* progress_ = nullptr;
+            std::function<void(output_type)> output_;
+    };
+
+    class task_sink
+    {
+        public:
+            using input_type = int;
+            using output_type = void;
+
+            task_sink(std::vector<int>& results) : results_(results) {}
+            task_sink(std::vector<int>& results, task_progress* progress) : results_(results), progress_{progress} {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                try
+                {
+                    while(true)
+                    {
+                        results_.push_back(input_());
+                        if(progress_ != nullptr)
+                            std::this_thread::sleep_for(std::chrono::microseconds{200});
+                    }
+                }
+                catch(const glados::pipeline::end_of_stream&)
+                {
+                    if(progress_ != nullptr)
+                        ++progress_->finished;
+                    throw;
+                }
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::vector<int>& results_;
+            task_progress* progress_ = nullptr;
+    };
+
+    class failing
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)>) -> void {}
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                input_();
+                throw std::runtime_error{"failing stage"};
+            }
+
+        private:
+            std::function<input_type()> input_;
+    };
+
+    // takes its time to shut down after the end of its input
+    class lingering_sink
+    {
+        public:
+            using input_type = int;
+            using output_type = void;
+
+            lingering_sink(std::atomic<bool>* stopped) : stopped_{stopped} {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                try
+                {
+                    while(true)
+                        input_();
+                }
+                catch(const glados::pipeline::end_of_stream&)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                    stopped_->store(true);
+                    throw;
+                }
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::atomic<bool>* stopped_;
+    };
+
+    auto check_results(const std::vector<int>& results) -> void
+    {
+        BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count));
+        for(auto i = 0; i < item_count; ++i)
+            BOOST_CHECK_EQUAL(results[static_cast<std::size_t>(i)], i * 2);
+    }
+
+    auto run_linear(glados::pipeline::wait_policy policy, std::size_t limit) -> void
+    {
+        auto results = std::vector<int>{};
+        auto p = glados::pipeline::pipeline{};
+
+        auto src = p.make_stage<source>();
+        auto dbl = p.make_stage<doubler>(limit);
+        auto snk = p.make_stage<sink>(limit, results);
+        dbl.set_wait_policy(policy);
+        snk.set_wait_policy(policy);
+
+        p.connect(src, dbl, snk);
+        p.run(src, dbl, snk);
+        p.wait();
+
+        check_results(results);
+    }
+
+    template <class QueueT>
+    auto check_drain_after_close(QueueT& q) -> void
+    {
+        q.push(1);
+        q.push(2);
+        q.close();
+        BOOST_CHECK(q.closed());
+
+        // belongs to the next stream
+        q.push(3);
+        BOOST_CHECK_EQUAL(q.pop(), 1);
+        BOOST_CHECK_EQUAL(q.pop(), 2);
+        BOOST_CHECK_THROW(q.pop(), glados::pipeline::end_of_stream);
+        BOOST_CHECK_THROW(q.pop(), glados::pipeline::end_of_stream);
+
+        q.reopen();
+        BOOST_CHECK(!q.closed());
+        BOOST_CHECK_EQUAL(q.pop(), 3);
+
+        q.cancel();
+        BOOST_CHECK_THROW(q.push(5), glados::pipeline::end_of_stream);
+        BOOST_CHECK_THROW(q.pop(), glados::pipeline::end_of_stream);
+
+        q.reset();
+        BOOST_CHECK(!q.closed());
+        q.push(4);
+        BOOST_CHECK_EQUAL(q.pop(), 4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_yield_wait)
+{
+    run_linear(glados::pipeline::yield_wait, 0);
+    run_linear(glados::pipeline::yield_wait, 4);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_block_wait)
+{
+    run_linear(glados::pipeline::block_wait, 0);
+    run_linear(glados::pipeline::block_wait, 4);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_spin_then_park)
+{
+    run_linear(glados::pipeline::spin_then_park, 0);
+    run_linear(glados::pipeline::spin_then_park, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_spsc_queue)
+{
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto dbl = p.make_stage<doubler, glados::pipeline::spsc_queue>(std::size_t{8});
+    auto snk = p.make_stage<sink, glados::pipeline::spsc_queue>(std::size_t{3}, results);
+
+    p.connect(src, dbl, snk);
+    p.run(src, dbl, snk);
+    p.wait();
+
+    check_results(results);
+}
+
+BOOST_AUTO_TEST_CASE(spsc_queue_wraps_around)
+{
+    auto q = glados::pipeline::spsc_queue<std::vector<int>>{5, glados::pipeline::block_wait};
+
+    for(auto round = 0; round < 100; ++round)
+    {
+        for(auto i = 0; i < 5; ++i)
+            q.push(std::vector<int>(static_cast<std::size_t>(i), round));
+
+        BOOST_CHECK_EQUAL(q.size(), 5u);
+
+        for(auto i = 0; i < 5; ++i)
+        {
+            auto v = q.pop();
+            BOOST_CHECK_EQUAL(v.size(), static_cast<std::size_t>(i));
+        }
+    }
+
+    BOOST_CHECK_EQUAL(q.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(mpmc_queue_many_producers_and_consumers)
+{
+    constexpr auto threads = 4;
+    constexpr auto per_thread = 5000;
+
+    auto q = glados::pipeline::mpmc_queue<int>{16};
+    auto results = std::vector<std::vector<int>>(threads);
+    auto workers = std::vector<std::thread>{};
+
+    for(auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&q, t]() {
+            for(auto i = 0; i < per_thread; ++i)
+                q.push(t * per_thread + i);
+        });
+        workers.emplace_back([&q, &results, t]() {
+            for(auto i = 0; i < per_thread; ++i)
+                results[static_cast<std::size_t>(t)].push_back(q.pop());
+        });
+    }
+
+    for(auto&& w : workers)
+        w.join();
+
+    auto all = std::vector<int>{};
+    for(auto&& r : results)
+        all.insert(std::end(all), std::begin(r), std::end(r));
+
+    std::sort(std::begin(all), std::end(all));
+    BOOST_REQUIRE_EQUAL(all.size(), static_cast<std::size_t>(threads * per_thread));
+    for(auto i = 0; i < threads * per_thread; ++i)
+        BOOST_CHECK_EQUAL(all[static_cast<std::size_t>(i)], i);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_fan_out_fan_in)
+{
+    constexpr auto workers = 4;
+
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto w0 = p.make_stage<doubler>(item_count / workers);
+    auto w1 = p.make_stage<doubler>(item_count / workers);
+    auto w2 = p.make_stage<doubler>(item_count / workers);
+    auto w3 = p.make_stage<doubler>(item_count / workers);
+    auto snk = p.make_stage<sink, glados::pipeline::mpmc_queue>(std::size_t{64}, results);
+
+    p.connect(src, glados::pipeline::parallel(w0, w1, w2, w3), snk);
+    p.run(src, w0, w1, w2, w3, snk);
+    p.wait();
+
+    std::sort(std::begin(results), std::end(results));
+    check_results(results);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_replicated_stage)
+{
+    constexpr auto replicas = 4;
+    using glados::pipeline::ordering;
+
+    for(auto order : {ordering::preserve, ordering::unordered})
+    {
+        auto results = std::vector<int>{};
+        auto p = glados::pipeline::pipeline{};
+
+        auto src = p.make_stage<source>();
+        auto rep = p.make_replicated_stage<replica>(replicas, 32, order);
+        auto snk = p.make_stage<sink, glados::pipeline::mpmc_queue>(std::size_t{32}, results);
+        BOOST_CHECK_EQUAL(rep.replicas(), static_cast<std::size_t>(replicas));
+
+        p.connect(src, rep, snk);
+        p.run(src, rep, snk);
+        p.wait();
+
+        if(order == ordering::unordered)
+            std::sort(std::begin(results), std::end(results));
+
+        // item_count / 2 even inputs, each emitted twice
+        BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count));
+        for(auto i = 0; i < item_count; ++i)
+            BOOST_CHECK_EQUAL(results[static_cast<std::size_t>(i)], (i / 2) * 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(replicated_stage_keeps_outputs_after_end_of_stream)
+{
+    constexpr auto replicas = 4;
+
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto rep = p.make_replicated_stage<tally>(replicas, 32, glados::pipeline::ordering::preserve);
+    auto snk = p.make_stage<sink, glados::pipeline::mpmc_queue>(std::size_t{32}, results);
+
+    p.connect(src, rep, snk);
+    p.run(src, rep, snk);
+    p.wait();
+
+    // the inputs in order, followed by one count per replica
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count + replicas));
+    for(auto i = 0; i < item_count; ++i)
+        BOOST_REQUIRE_EQUAL(results[static_cast<std::size_t>(i)], i);
+
+    auto seen = 0;
+    for(auto i = item_count; i < item_count + replicas; ++i)
+        seen -= results[static_cast<std::size_t>(i)];
+    BOOST_CHECK_EQUAL(seen, item_count);
+}
+
+BOOST_AUTO_TEST_CASE(replicated_stage_bounds_outputs_behind_a_slow_input)
+{
+    constexpr auto replicas = 4;
+    constexpr auto limit = std::size_t{16};
+
+    stall s;
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto rep = p.make_replicated_stage<stalling>(replicas, limit, glados::pipeline::ordering::preserve, &s);
+    auto snk = p.make_stage<sink>(std::size_t{32}, results);
+
+    p.connect(src, rep, snk);
+    p.run(src, rep, snk);
+
+    // the other replicas run at most one window ahead of input 0
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    BOOST_CHECK_LE(s.emitted.load(), static_cast<int>(limit));
+
+    s.released.store(true);
+    p.wait();
+
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count));
+    for(auto i = 0; i < item_count; ++i)
+        BOOST_REQUIRE_EQUAL(results[static_cast<std::size_t>(i)], i);
+}
+
+BOOST_AUTO_TEST_CASE(replicated_stage_preserves_order_of_concurrent_producers)
+{
+    constexpr auto workers = 4;
+    constexpr auto replicas = 4;
+
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    // the producers fill the short queue concurrently, so several of them wait for room at once
+    auto src = p.make_stage<source>();
+    auto w0 = p.make_stage<doubler>(item_count / workers);
+    auto w1 = p.make_stage<doubler>(item_count / workers);
+    auto w2 = p.make_stage<doubler>(item_count / workers);
+    auto w3 = p.make_stage<doubler>(item_count / workers);
+    auto rep = p.make_replicated_stage<replica>(replicas, 2, glados::pipeline::ordering::preserve);
+    auto snk = p.make_stage<sink>(std::size_t{4}, results);
+
+    p.connect(src, glados::pipeline::parallel(w0, w1, w2, w3), rep, snk);
+    p.run(src, w0, w1, w2, w3, rep, snk);
+    p.wait();
+
+    // every input is even and emitted twice, both copies leave the stage together
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(2 * item_count));
+    for(auto i = std::size_t{0}; i < results.size(); i += 2)
+        BOOST_REQUIRE_EQUAL(results[i], results[i + 1]);
+
+    std::sort(std::begin(results), std::end(results));
+    for(auto i = 0; i < item_count; ++i)
+        BOOST_REQUIRE_EQUAL(results[static_cast<std::size_t>(2 * i)], 2 * i);
+}
+
+BOOST_AUTO_TEST_CASE(output_side_least_loaded)
+{
+    using port_type = glados::pipeline::input_side<int>;
+
+    auto busy = port_type{};
+    auto idle = port_type{};
+    for(auto i = 0; i < 3; ++i)
+        busy.input(int{i});
+
+    auto out = glados::pipeline::output_side<int>{};
+    out.attach({&busy, &idle}, glados::pipeline::distribution::least_loaded);
+
+    for(auto i = 0; i < 4; ++i)
+        out.output(int{i});
+
+    BOOST_CHECK_EQUAL(busy.size(), 3u);
+    BOOST_CHECK_EQUAL(idle.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(queues_drain_after_close)
+{
+    auto blocking = glados::pipeline::blocking_queue<int>{4};
+    auto spsc = glados::pipeline::spsc_queue<int>{4};
+    auto mpmc = glados::pipeline::mpmc_queue<int>{4};
+    check_drain_after_close(blocking);
+    check_drain_after_close(spsc);
+    check_drain_after_close(mpmc);
+}
+
+BOOST_AUTO_TEST_CASE(close_releases_waiting_consumer)
+{
+    auto q = glados::pipeline::spsc_queue<int>{4, glados::pipeline::block_wait};
+    auto released = false;
+
+    auto consumer = std::thread{[&]() {
+        try
+        {
+            q.pop();
+        }
+        catch(const glados::pipeline::end_of_stream&)
+        {
+            released = true;
+        }
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    q.close();
+    consumer.join();
+    BOOST_CHECK(released);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_end_of_stream_fan_in)
+{
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto w0 = p.make_stage<doubler>();
+    auto w1 = p.make_stage<doubler>();
+    auto w2 = p.make_stage<doubler>();
+    auto snk = p.make_stage<sink, glados::pipeline::mpmc_queue>(std::size_t{64}, results);
+
+    p.connect(src, glados::pipeline::parallel(w0, w1, w2), snk);
+
+    // the same stages run twice, as between two scans
+    for(auto run = 0; run < 2; ++run)
+    {
+        results.clear();
+        w0.reset_input();
+        w1.reset_input();
+        w2.reset_input();
+        snk.reset_input();
+
+        p.run(src, w0, w1, w2, snk);
+        p.wait();
+
+        std::sort(std::begin(results), std::end(results));
+        check_results(results);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_stops_upstream_when_sink_returns)
+{
+    constexpr auto wanted = 100;
+
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>(-1);
+    auto dbl = p.make_stage<doubler>(std::size_t{8});
+    auto snk = p.make_stage<sink>(std::size_t{8}, results, wanted);
+
+    p.connect(src, dbl, snk);
+    p.run(src, dbl, snk);
+    p.wait();
+
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(wanted));
+    for(auto i = 0; i < wanted; ++i)
+        BOOST_CHECK_EQUAL(results[static_cast<std::size_t>(i)], i * 2);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_on_thread_pool)
+{
+    glados::generic::thread_pool pool{3};
+
+    for(auto run = 0; run < 3; ++run)
+    {
+        auto results = std::vector<int>{};
+        auto p = glados::pipeline::pipeline{&pool};
+
+        auto src = p.make_stage<source>();
+        auto dbl = p.make_stage<doubler>(std::size_t{16});
+        auto snk = p.make_stage<sink>(std::size_t{16}, results);
+
+        p.connect(src, dbl, snk);
+        p.run(src, dbl, snk);
+        p.wait();
+
+        check_results(results);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(replicated_stage_on_thread_pool)
+{
+    constexpr auto replicas = 3;
+    glados::generic::thread_pool pool{replicas + 2};
+
+    // every worker notes its id while all of them are kept busy
+    thread_log workers;
+    std::atomic<int> arrived{0};
+    auto futures = std::vector<std::future<void>>{};
+    for(auto i = std::size_t{0}; i < pool.size(); ++i)
+    {
+        futures.emplace_back(pool.submit([&]() {
+            workers.add();
+            ++arrived;
+            while(arrived.load() < static_cast<int>(pool.size()))
+                std::this_thread::yield();
+        }));
+    }
+    for(auto&& f : futures)
+        f.get();
+    BOOST_REQUIRE_EQUAL(workers.ids.size(), pool.size());
+
+    thread_log log;
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{&pool};
+
+    auto src = p.make_stage<source>();
+    auto rep = p.make_replicated_stage<logged>(replicas, 32, glados::pipeline::ordering::preserve, &log);
+    auto snk = p.make_stage<sink>(std::size_t{32}, results);
+
+    p.connect(src, rep, snk);
+    p.run(src, rep, snk);
+    p.wait();
+
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count));
+    BOOST_CHECK_EQUAL(log.ids.size(), static_cast<std::size_t>(replicas));
+    for(auto&& id : log.ids)
+        BOOST_CHECK(workers.ids.count(id) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(task_pipeline_on_thread_pool)
+{
+    constexpr auto tasks = 20;
+
+    glados::generic::thread_pool pool{3};
+    auto results = std::vector<int>{};
+    glados::pipeline::task_queue<int> q{std::queue<int>{}};
+    for(auto t = 0; t < tasks; ++t)
+        q.push(int{t});
+
+    auto p = glados::pipeline::task_pipeline<int>{&q, &pool};
+    auto src = p.make_stage<task_source>();
+    auto dbl = p.make_stage<doubler>(std::size_t{4});
+    auto snk = p.make_stage<task_sink>(std::size_t{4}, results);
+
+    p.connect(src, dbl, snk);
+    p.run(src, dbl, snk);
+    p.wait();
+
+    auto expected = std::vector<int>{};
+    for(auto t = 0; t < tasks; ++t)
+        for(auto i = 0; i < t; ++i)
+            expected.push_back(i * 2);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(results), std::end(results), std::begin(expected), std::end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(task_pipeline_joins_stages_before_rethrowing)
+{
+    glados::generic::thread_pool pool{3};
+    glados::pipeline::task_queue<int> q{std::queue<int>{}};
+    q.push(int{5});
+
+    std::atomic<bool> stopped{false};
+    auto p = glados::pipeline::task_pipeline<int>{&q, &pool};
+    auto src = p.make_stage<task_source>();
+    auto bad = p.make_stage<failing>(std::size_t{4});
+    auto snk = p.make_stage<lingering_sink>(std::size_t{4}, &stopped);
+
+    p.connect(src, bad, snk);
+    p.run(src, bad, snk);
+    BOOST_CHECK_THROW(p.wait(), std::runtime_error);
+    BOOST_CHECK(stopped.load());
+}
+
+BOOST_AUTO_TEST_CASE(task_pipeline_overlapped)
+{
+    constexpr auto tasks = 12;
+    constexpr auto in_flight = 3;
+
+    glados::generic::thread_pool pool{3};
+    for(auto executor : {static_cast<glados::generic::thread_pool*>(nullptr), &pool})
+    {
+        task_progress progress;
+        auto results = std::vector<int>{};
+        glados::pipeline::task_queue<int> q{std::queue<int>{}};
+        for(auto t = 0; t < tasks; ++t)
+            q.push(int{t + 1});
+
+        auto p = glados::pipeline::task_pipeline<int>{&q, executor, in_flight};
+        auto src = p.make_stage<task_source>(&progress);
+        auto dbl = p.make_stage<doubler>(std::size_t{4});
+        auto snk = p.make_stage<task_sink>(std::size_t{4}, results, &progress);
+
+        p.connect(src, dbl, snk);
+        p.run(src, dbl, snk);
+        p.wait();
+
+        auto expected = std::vector<int>{};
+        for(auto t = 0; t < tasks; ++t)
+            for(auto i = 0; i <= t; ++i)
+                expected.push_back(i * 2);
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(results), std::end(results), std::begin(expected), std::end(expected));
+        BOOST_CHECK_EQUAL(progress.finished.load(), tasks);
+
+        // the source ran ahead of the slow sink, but never by more than in_flight tasks
+        BOOST_CHECK_GT(progress.max_ahead.load(), 1);
+        BOOST_CHECK_LE(progress.max_ahead.load(), in_flight);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(task_pipeline_overlapped_rejects_fan_in)
+{
+    auto results = std::vector<int>{};
+    glados::pipeline::task_queue<int> q{std::queue<int>{}};
+
+    auto p = glados::pipeline::task_pipeline<int>{&q, nullptr, 2};
+    auto s0 = p.make_stage<task_source>();
+    auto s1 = p.make_stage<task_source>();
+    auto snk = p.make_stage<task_sink, glados::pipeline::mpmc_queue>(std::size_t{4}, results);
+
+    p.connect(glados::pipeline::parallel(s0, s1), snk);
+    BOOST_CHECK_THROW(p.run(s0, s1, snk), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_try_pop_shared)
+{
+    constexpr auto tasks = 20000;
+    constexpr auto consumers = 4;
+
+    glados::pipeline::task_queue<int> q{std::queue<int>{}};
+    for(auto t = 0; t < tasks; ++t)
+        q.push(int{t});
+
+    auto taken = std::vector<std::vector<int>>(consumers);
+    auto threads = std::vector<std::thread>{};
+    for(auto c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&q, &taken, c]() {
+            auto t = 0;
+            while(q.try_pop(t))
+                taken[static_cast<std::size_t>(c)].push_back(t);
+        });
+    }
+
+    for(auto&& t : threads)
+        t.join();
+
+    auto all = std::vector<int>{};
+    for(auto&& t : taken)
+        all.insert(std::end(all), std::begin(t), std::end(t));
+
+    std::sort(std::begin(all), std::end(all));
+    BOOST_REQUIRE_EQUAL(all.size(), static_cast<std::size_t>(tasks));
+    for(auto t = 0; t < tasks; ++t)
+        BOOST_CHECK_EQUAL(all[static_cast<std::size_t>(t)], t);
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(work_stealing_queue_balances_load)
+{
+    constexpr auto tasks = 20000;
+    constexpr auto workers = 4;
+
+    // every task starts on the first worker, the others have to steal
+    glados::pipeline::work_stealing_queue<int> q{workers};
+    for(auto t = 0; t < tasks; ++t)
+        q.push(0, int{t});
+
+    auto taken = std::vector<std::vector<int>>(workers);
+    auto threads = std::vector<std::thread>{};
+    for(auto w = 0; w < workers; ++w)
+    {
+        threads.emplace_back([&q, &taken, w]() {
+            auto handle = q.get_worker(static_cast<std::size_t>(w));
+            auto t = 0;
+            while(handle.try_pop(t))
+            {
+                taken[static_cast<std::size_t>(w)].push_back(t);
+                if(t % 64 == 0)
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for(auto&& t : threads)
+        t.join();
+
+    auto all = std::vector<int>{};
+    for(auto&& t : taken)
+        all.insert(std::end(all), std::begin(t), std::end(t));
+
+    std::sort(std::begin(all), std::end(all));
+    BOOST_REQUIRE_EQUAL(all.size(), static_cast<std::size_t>(tasks));
+    for(auto t = 0; t < tasks; ++t)
+        BOOST_CHECK_EQUAL(all[static_cast<std::size_t>(t)], t);
+    BOOST_CHECK(q.empty());
+
+    // the owner takes its tasks in order
+    BOOST_CHECK(std::is_sorted(std::begin(taken[0]), std::end(taken[0])));
+}
+
+BOOST_AUTO_TEST_CASE(task_pipelines_share_work_stealing_queue)
+{
+    constexpr auto tasks = 40;
+    constexpr auto pipelines = 2;
+
+    using queue_type = glados::pipeline::work_stealing_queue<int>;
+    using pipeline_type = glados::pipeline::task_pipeline<int, queue_type::worker>;
+
+    auto initial = std::queue<int>{};
+    for(auto t = 0; t < tasks; ++t)
+        initial.push(t % 5);
+    queue_type q{pipelines, initial};
+
+    auto handles = std::vector<queue_type::worker>{q.get_worker(0), q.get_worker(1)};
+    auto results = std::vector<std::vector<int>>(pipelines);
+
+    auto p0 = pipeline_type{&handles[0]};
+    auto src0 = p0.make_stage<task_source>();
+    auto snk0 = p0.make_stage<task_sink>(std::size_t{4}, results[0]);
+    p0.connect(src0, snk0);
+
+    auto p1 = pipeline_type{&handles[1]};
+    auto src1 = p1.make_stage<task_source>();
+    auto snk1 = p1.make_stage<task_sink>(std::size_t{4}, results[1]);
+    p1.connect(src1, snk1);
+
+    p0.run(src0, snk0);
+    p1.run(src1, snk1);
+    p0.wait();
+    p1.wait();
+
+    // every task emits 0..task-1
+    auto expected = std::size_t{0};
+    for(auto t = 0; t < tasks; ++t)
+        expected += static_cast<std::size_t>(t % 5);
+
+    BOOST_CHECK_EQUAL(results[0].size() + results[1].size(), expected);
+    BOOST_CHECK(q.empty());
+}
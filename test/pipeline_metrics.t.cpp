@@ -0,0 +1,179 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE PipelineMetrics
+#include <boost/test/unit_test.hpp>
+
+#define GLADOS_PIPELINE_METRICS
+#include <glados/pipeline/pipeline.h>
+
+namespace
+{
+    constexpr auto item_count = 200;
+
+    class source
+    {
+        public:
+            using input_type = void;
+            using output_type = int;
+
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto run() -> void
+            {
+                for(auto i = 0; i < item_count; ++i)
+                    output_(i);
+            }
+
+        private:
+            std::function<void(output_type)> output_;
+    };
+
+    // the bottleneck
+    class slow
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto v = input_();
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    output_(v);
+                }
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    class sink
+    {
+        public:
+            using input_type = int;
+            using output_type = void;
+
+            sink(std::vector<int>& results) : results_(results) {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+
+            auto run() -> void
+            {
+                while(true)
+                    results_.push_back(input_());
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::vector<int>& results_;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(stage_metrics_find_the_bottleneck)
+{
+    static_assert(glados::pipeline::metrics_enabled, "GLADOS_PIPELINE_METRICS is not picked up");
+
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto slw = p.make_stage<slow>(std::size_t{8});
+    auto snk = p.make_stage<sink>(std::size_t{0}, results);
+
+    auto samples = 0;
+    auto last = glados::pipeline::metrics_monitor::sample{};
+    auto monitor = std::unique_ptr<glados::pipeline::metrics_monitor>{new glados::pipeline::metrics_monitor{
+        std::chrono::milliseconds{1}, [&](const glados::pipeline::metrics_monitor::sample& s) { ++samples; last = s; }}};
+    monitor->watch("source", src);
+    monitor->watch("slow", slw);
+    monitor->watch("sink", snk);
+    monitor->start();
+
+    p.connect(src, slw, snk);
+    p.run(src, slw, snk);
+    p.wait();
+    monitor->stop();
+
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count));
+    BOOST_CHECK(samples >= 1);
+    BOOST_REQUIRE_EQUAL(last.size(), 3u);
+    BOOST_CHECK_EQUAL(last[1].first, "slow");
+
+    auto src_m = src.metrics();
+    auto slw_m = slw.metrics();
+    auto snk_m = snk.metrics();
+
+    BOOST_CHECK_EQUAL(src_m.items_in, 0u);
+    BOOST_CHECK_EQUAL(src_m.items_out, static_cast<std::uint64_t>(item_count));
+    BOOST_CHECK_EQUAL(slw_m.items_in, static_cast<std::uint64_t>(item_count));
+    BOOST_CHECK_EQUAL(slw_m.items_out, static_cast<std::uint64_t>(item_count));
+    BOOST_CHECK_EQUAL(snk_m.items_in, static_cast<std::uint64_t>(item_count));
+    BOOST_CHECK_EQUAL(last[2].second.items_in, snk_m.items_in);
+
+    // the source is held back by the slow stage, the sink waits for it
+    BOOST_CHECK(slw_m.queue_high_water >= 1u);
+    BOOST_CHECK(slw_m.queue_high_water <= 8u);
+    BOOST_CHECK(src_m.output_wait > slw_m.output_wait);
+    BOOST_CHECK(snk_m.input_wait > snk_m.busy_time());
+    BOOST_CHECK(slw_m.busy_time() > slw_m.input_wait);
+    BOOST_CHECK(slw_m.run_time >= std::chrono::microseconds{100 * item_count});
+
+    slw.reset_metrics();
+    BOOST_CHECK_EQUAL(slw.metrics().items_in, 0u);
+    BOOST_CHECK(slw.metrics().run_time == std::chrono::nanoseconds{0});
+}
+
+BOOST_AUTO_TEST_CASE(replicated_stage_metrics_are_summed)
+{
+    auto results = std::vector<int>{};
+    auto p = glados::pipeline::pipeline{};
+
+    auto src = p.make_stage<source>();
+    auto rep = p.make_replicated_stage<slow>(3, 16, glados::pipeline::ordering::preserve);
+    auto snk = p.make_stage<sink>(std::size_t{0}, results);
+
+    p.connect(src, rep, snk);
+    p.run(src, rep, snk);
+    p.wait();
+
+    BOOST_REQUIRE_EQUAL(results.size(), static_cast<std::size_t>(item_count));
+    auto m = rep.metrics();
+    BOOST_CHECK_EQUAL(m.items_in, static_cast<std::uint64_t>(item_count));
+    BOOST_CHECK_EQUAL(m.items_out, static_cast<std::uint64_t>(item_count));
+    BOOST_CHECK(m.queue_high_water <= 16u);
+    BOOST_CHECK(m.run_time >= std::chrono::microseconds{100 * item_count});
+}
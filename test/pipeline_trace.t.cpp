@@ -0,0 +1,279 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE PipelineTrace
+#include <boost/test/unit_test.hpp>
+
+#define GLADOS_PIPELINE_TRACE
+#include <glados/generic/thread_pool.h>
+#include <glados/pipeline/pipeline.h>
+
+namespace
+{
+    class task_source
+    {
+        public:
+            using input_type = void;
+            using output_type = int;
+
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+            auto assign_task(int task) -> void { count_ = task; }
+
+            auto run() -> void
+            {
+                for(auto i = 0; i < count_; ++i)
+                    output_(i);
+            }
+
+        private:
+            int count_ = 0;
+            std::function<void(output_type)> output_;
+    };
+
+    class doubler
+    {
+        public:
+            using input_type = int;
+            using output_type = int;
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) -> void { output_ = f; }
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                while(true)
+                    output_(input_() * 2);
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    class task_sink
+    {
+        public:
+            using input_type = int;
+            using output_type = void;
+
+            task_sink(std::vector<int>& results) : results_(results) {}
+
+            auto set_input_function(std::function<input_type()> f) -> void { input_ = f; }
+            auto assign_task(int) -> void {}
+
+            auto run() -> void
+            {
+                while(true)
+                    results_.push_back(input_());
+            }
+
+        private:
+            std::function<input_type()> input_;
+            std::vector<int>& results_;
+    };
+
+    struct trace_summary
+    {
+        std::map<std::string, int> counts; // "<phase> <name>"
+        std::map<std::string, int> depth;  // open B events per tid
+        bool balanced = true;
+    };
+
+    auto field(const std::string& line, const std::string& key) -> std::string
+    {
+        auto pos = line.find("\"" + key + "\":");
+        BOOST_REQUIRE(pos != std::string::npos);
+        pos += key.size() + 3;
+        if(line[pos] == '"')
+            return line.substr(pos + 1, line.find('"', pos + 1) - pos - 1);
+        return line.substr(pos, line.find_first_of(",}", pos) - pos);
+    }
+
+    // every event is written on a line of its own
+    auto summarize(const std::string& json) -> trace_summary
+    {
+        auto ret = trace_summary{};
+        auto is = std::istringstream{json};
+        auto line = std::string{};
+        while(std::getline(is, line))
+        {
+            if(line.compare(0, 9, "{\"name\":\"") != 0)
+                continue;
+
+            auto phase = field(line, "ph");
+            auto tid = field(line, "tid");
+            ++ret.counts[phase + " " + field(line, "name")];
+            if(phase == "B")
+                ++ret.depth[tid];
+            else if((phase == "E") && (--ret.depth[tid] < 0))
+                ret.balanced = false;
+        }
+
+        for(auto&& d : ret.depth)
+            ret.balanced = ret.balanced && (d.second == 0);
+        return ret;
+    }
+
+    // the values of key of all events called name
+    auto collect(const std::string& json, const std::string& name, const std::string& key) -> std::multiset<std::string>
+    {
+        auto ret = std::multiset<std::string>{};
+        auto is = std::istringstream{json};
+        auto line = std::string{};
+        while(std::getline(is, line))
+        {
+            if((line.compare(0, 9, "{\"name\":\"") == 0) && (field(line, "name") == name))
+                ret.insert(field(line, key));
+        }
+        return ret;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(task_pipeline_trace)
+{
+    static_assert(glados::pipeline::trace_enabled, "GLADOS_PIPELINE_TRACE is not picked up");
+    constexpr auto tasks = 5;
+
+    auto& tracer = glados::pipeline::tracer::instance();
+    glados::generic::thread_pool pool{3};
+    for(auto in_flight : {1, 3})
+    {
+        tracer.clear();
+        tracer.start();
+
+        auto results = std::vector<int>{};
+        glados::pipeline::task_queue<int> q{std::queue<int>{}};
+        for(auto t = 0; t < tasks; ++t)
+            q.push(int{t + 1});
+
+        auto p = glados::pipeline::task_pipeline<int>{&q, &pool, static_cast<std::size_t>(in_flight)};
+        auto src = p.make_stage<task_source>();
+        auto dbl = p.make_stage<doubler>(std::size_t{4});
+        auto snk = p.make_stage<task_sink>(std::size_t{4}, results);
+        src.set_trace_name("source");
+        dbl.set_trace_name("doubler");
+        snk.set_trace_name("sink");
+
+        p.connect(src, dbl, snk);
+        p.run(src, dbl, snk);
+        p.wait();
+        tracer.stop();
+
+        auto os = std::ostringstream{};
+        tracer.write(os);
+        auto json = os.str();
+        BOOST_CHECK_EQUAL(json.compare(0, 16, "{\"traceEvents\":["), 0);
+        BOOST_CHECK_EQUAL(tracer.dropped(), 0u);
+
+        auto s = summarize(json);
+        BOOST_CHECK(s.balanced);
+        BOOST_CHECK_EQUAL(s.counts["b task"], tasks);
+        BOOST_CHECK_EQUAL(s.counts["e task"], tasks);
+        BOOST_CHECK_EQUAL(s.counts["B source"], tasks);
+        BOOST_CHECK_EQUAL(s.counts["B doubler"], tasks);
+        BOOST_CHECK_EQUAL(s.counts["B sink"], tasks);
+
+        // one item per input, the source has one more span after its last output
+        auto items = tasks * (tasks + 1) / 2;
+        BOOST_CHECK_EQUAL(s.counts["B item"], 3 * items + tasks);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(trace_records_while_started)
+{
+    auto& tracer = glados::pipeline::tracer::instance();
+    tracer.clear();
+
+    tracer.record('B', "ignored");
+    tracer.start();
+    tracer.record('B', "say \"hi\"");
+    tracer.stop();
+    tracer.record('E', "ignored");
+
+    auto os = std::ostringstream{};
+    tracer.write(os);
+    BOOST_CHECK_EQUAL(os.str().find("ignored"), std::string::npos);
+    BOOST_CHECK(os.str().find("\"name\":\"say \\\"hi\\\"\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(trace_task_ids_differ_between_pipelines)
+{
+    constexpr auto tasks = 3;
+
+    auto& tracer = glados::pipeline::tracer::instance();
+    glados::generic::thread_pool pool{3};
+    tracer.clear();
+    tracer.start();
+    for(auto in_flight : {1, 1, 2})
+    {
+        auto results = std::vector<int>{};
+        glados::pipeline::task_queue<int> q{std::queue<int>{}};
+        for(auto t = 0; t < tasks; ++t)
+            q.push(int{t + 1});
+
+        auto p = glados::pipeline::task_pipeline<int>{&q, &pool, static_cast<std::size_t>(in_flight)};
+        auto src = p.make_stage<task_source>();
+        auto snk = p.make_stage<task_sink>(std::size_t{4}, results);
+        p.connect(src, snk);
+        p.run(src, snk);
+        p.wait();
+    }
+    tracer.stop();
+
+    auto os = std::ostringstream{};
+    tracer.write(os);
+    auto ids = collect(os.str(), "task", "id");
+    BOOST_CHECK_EQUAL(ids.size(), 2u * 3u * tasks);
+    for(auto&& id : ids)
+        BOOST_CHECK_EQUAL(ids.count(id), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(trace_reuses_buffers_of_exited_threads)
+{
+    auto& tracer = glados::pipeline::tracer::instance();
+    tracer.clear();
+
+    tracer.start();
+    for(auto i = 0; i < 8; ++i)
+    {
+        auto t = std::thread{[&tracer]() { tracer.record('i', "exited"); }};
+        t.join();
+    }
+    tracer.stop();
+
+    auto os = std::ostringstream{};
+    tracer.write(os);
+    auto tids = collect(os.str(), "exited", "tid");
+    BOOST_CHECK_EQUAL(tids.size(), 8u);
+    BOOST_CHECK_EQUAL(tids.count(*tids.begin()), 8u);
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define BOOST_TEST_MODULE PitchedAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/pitched_allocator.h>
+#include <glados/memory.h>
+
+BOOST_AUTO_TEST_CASE(pitched_rows_are_aligned)
+{
+    auto alloc = glados::generic::pitched_allocator<float, glados::memory_layout::pointer_2D>{};
+
+    auto p = alloc.allocate(100, 7);
+    BOOST_CHECK_EQUAL(p.pitch(), 448u);
+    for(auto r = std::size_t{0}; r < 7; ++r)
+    {
+        auto row = reinterpret_cast<std::uintptr_t>(p.ptr()) + r * p.pitch();
+        BOOST_CHECK_EQUAL(row % 64, 0u);
+    }
+    alloc.deallocate(p);
+}
+
+BOOST_AUTO_TEST_CASE(power_of_two_rows_get_extra_padding)
+{
+    auto alloc = glados::generic::pitched_allocator<float, glados::memory_layout::pointer_3D, 32>{};
+
+    auto p = alloc.allocate(256, 4, 4);
+    BOOST_CHECK_EQUAL(p.pitch(), 1024u + 32u);
+    alloc.deallocate(p, 256, 4, 4);
+}
+
+BOOST_AUTO_TEST_CASE(pitched_unique_ptr_addresses_rows)
+{
+    auto p = glados::generic::make_unique_pitched<int>(10, 3, 2);
+    BOOST_CHECK(p != nullptr);
+    BOOST_CHECK(decltype(p)::pitched_memory);
+
+    for(auto r = std::size_t{0}; r < 6; ++r)
+        std::fill_n(p.row(r), 10, static_cast<int>(r));
+
+    BOOST_CHECK_EQUAL(p.row(5)[9], 5);
+    BOOST_CHECK_EQUAL(reinterpret_cast<unsigned char*>(p.row(1)) - reinterpret_cast<unsigned char*>(p.get()),
+                      static_cast<std::ptrdiff_t>(p.pitch()));
+
+    auto q = std::move(p);
+    BOOST_CHECK(p == nullptr);
+    BOOST_CHECK_EQUAL(q.row(2)[0], 2);
+}
+
+BOOST_AUTO_TEST_CASE(pitched_allocator_backs_a_pool)
+{
+    using internal = glados::generic::pitched_allocator<double, glados::memory_layout::pointer_2D>;
+    auto pool = glados::pool_allocator<double, glados::memory_layout::pointer_2D, internal>{};
+
+    auto first = pool.allocate_smart(33, 8);
+    auto pitch = first.pitch();
+    auto ptr = first.get();
+    first.reset();
+
+    auto second = pool.allocate_smart(33, 8);
+    BOOST_CHECK(second.get() == ptr);
+    BOOST_CHECK_EQUAL(second.pitch(), pitch);
+    second.reset();
+    pool.release();
+}
@@ -0,0 +1,742 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <new>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+#define BOOST_TEST_MODULE PoolAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/allocator.h>
+#include <glados/pipeline/blocking_queue.h>
+#include <glados/memory.h>
+
+namespace
+{
+    // what the calling thread allocated on the heap and how often it locked a mutex
+    thread_local auto heap_allocations = 0;
+    thread_local auto mutex_locks = 0;
+}
+
+auto operator new(std::size_t size) -> void*
+{
+    ++heap_allocations;
+    auto p = std::malloc((size == 0) ? 1 : size);
+    if(p == nullptr)
+        throw std::bad_alloc{};
+    return p;
+}
+
+// out of line, or GCC takes the free() for a mismatch once it sees both sides
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+auto operator delete(void* p) noexcept -> void
+{
+    std::free(p);
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+auto operator delete(void* p, std::size_t) noexcept -> void
+{
+    std::free(p);
+}
+
+#if defined(__linux__)
+// std::mutex locks through pthread_mutex_lock, this definition takes precedence over the C library's
+extern "C" auto pthread_mutex_lock(pthread_mutex_t* m) -> int
+{
+    using lock_type = int (*)(pthread_mutex_t*);
+    static auto next = reinterpret_cast<lock_type>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+    ++mutex_locks;
+    return next(m);
+}
+#endif
+
+namespace
+{
+    // counts the blocks which really reach the heap
+    template <class T, glados::memory_layout ml>
+    class counting_allocator : public glados::generic::allocator<T, ml>
+    {
+        public:
+            template <class... Args>
+            auto allocate(Args... args) -> typename glados::generic::allocator<T, ml>::pointer
+            {
+                ++allocated;
+                return glados::generic::allocator<T, ml>::allocate(args...);
+            }
+
+            template <class... Args>
+            auto deallocate(typename glados::generic::allocator<T, ml>::pointer p, Args... args) noexcept -> void
+            {
+                ++deallocated;
+                glados::generic::allocator<T, ml>::deallocate(p, args...);
+            }
+
+            static std::atomic<int> allocated;
+            static std::atomic<int> deallocated;
+    };
+
+    template <class T, glados::memory_layout ml>
+    std::atomic<int> counting_allocator<T, ml>::allocated{0};
+
+    template <class T, glados::memory_layout ml>
+    std::atomic<int> counting_allocator<T, ml>::deallocated{0};
+
+    using counting_1D = counting_allocator<int, glados::memory_layout::pointer_1D>;
+    using pool_1D = glados::pool_allocator<int, glados::memory_layout::pointer_1D, counting_1D>;
+
+    // keeps its deleter like cuda::unique_ptr does: copied in and copy-assigned on moves
+    template <class T, class Deleter>
+    class copying_ptr
+    {
+        public:
+            copying_ptr() noexcept = default;
+            copying_ptr(T* p, const Deleter& d) noexcept : p_{p}, deleter_(d) {}
+
+            copying_ptr(copying_ptr&& other) noexcept : p_{other.p_}
+            {
+                deleter_ = other.deleter_;
+                other.p_ = nullptr;
+            }
+
+            auto operator=(copying_ptr&& other) noexcept -> copying_ptr&
+            {
+                reset();
+                p_ = other.p_;
+                deleter_ = other.deleter_;
+                other.p_ = nullptr;
+                return *this;
+            }
+
+            ~copying_ptr()
+            {
+                if(p_ != nullptr)
+                    deleter_(p_);
+            }
+
+            auto reset() noexcept -> void
+            {
+                if(p_ != nullptr)
+                    deleter_(p_);
+                p_ = nullptr;
+            }
+
+        private:
+            T* p_ = nullptr;
+            Deleter deleter_;
+    };
+
+    class copying_1D : public counting_allocator<int, glados::memory_layout::pointer_1D>
+    {
+        public:
+            template <class Deleter>
+            using smart_pointer = copying_ptr<int, Deleter>;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(pool_recycles_blocks)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    auto blocks = std::vector<int*>{};
+    for(auto i = 0; i < 100; ++i)
+        blocks.push_back(pool.allocate(64));
+    for(auto p : blocks)
+        pool.deallocate(p);
+
+    auto again = std::vector<int*>{};
+    for(auto i = 0; i < 100; ++i)
+        again.push_back(pool.allocate(64));
+
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 100);
+    std::sort(std::begin(blocks), std::end(blocks));
+    std::sort(std::begin(again), std::end(again));
+    BOOST_CHECK(blocks == again);
+
+    for(auto p : again)
+        pool.deallocate(p);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(pool_serves_mixed_shapes)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    auto a = pool.allocate(64);
+    auto b = pool.allocate(128);
+    pool.deallocate(a, 64);
+    pool.deallocate(b, 128);
+
+    BOOST_CHECK_EQUAL(pool.allocate(128), b);
+    BOOST_CHECK_EQUAL(pool.allocate(64), a);
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 2);
+
+    // no free block of 100 elements, the smallest one that is large enough is taken
+    pool.deallocate(a, 64);
+    pool.deallocate(b, 128);
+    BOOST_CHECK_EQUAL(pool.allocate(100), b);
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 2);
+
+    auto c = pool.allocate(256);
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 3);
+
+    pool.deallocate(b, 100);
+    pool.deallocate(c, 256);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(pool_returns_best_fit_blocks_to_their_bucket)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    auto small = pool.allocate(64);
+    auto large = pool.allocate(256);
+    pool.deallocate(small, 64);
+    pool.deallocate(large, 256);
+
+    // no free block of 128 elements, the block of 256 elements is lent to that shape
+    BOOST_CHECK_EQUAL(pool.allocate(64), small);
+    BOOST_CHECK_EQUAL(pool.allocate(128), large);
+    pool.deallocate(large, 128);
+    pool.deallocate(small, 64);
+
+    BOOST_CHECK_EQUAL(pool.allocate(256), large);
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 2);
+    pool.deallocate(large, 256);
+
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 2);
+    BOOST_CHECK_EQUAL(pool.stats().bytes_held, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(pool_needs_the_shape_once_it_serves_several)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    // a single shape is known without being passed
+    auto a = pool.allocate(16);
+    pool.deallocate(a);
+    BOOST_CHECK_EQUAL(pool.allocate(16), a);
+
+    // afterwards a block without its shape can't be told apart, it is freed instead of recycled
+    auto large = pool.allocate(256);
+    pool.deallocate(large);
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 1);
+
+    pool.deallocate(a, 16);
+    BOOST_CHECK_EQUAL(pool.allocate(16), a);
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 2);
+
+    pool.deallocate(a, 16);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(pool_serves_any_number_of_shapes)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    // e.g. a detector ROI which changes with every scan
+    auto blocks = std::vector<int*>{};
+    for(auto n = 1; n <= 200; ++n)
+        blocks.push_back(pool.allocate(static_cast<std::size_t>(n)));
+    for(auto n = 1; n <= 200; ++n)
+        pool.deallocate(blocks[static_cast<std::size_t>(n - 1)], static_cast<std::size_t>(n));
+
+    BOOST_CHECK_EQUAL(pool.allocate(200), blocks.back());
+    pool.deallocate(blocks.back(), 200);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 200);
+    BOOST_CHECK_EQUAL(pool.stats().bytes_held, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(pool_best_fit_checks_every_dimension)
+{
+    using counting_2D = counting_allocator<int, glados::memory_layout::pointer_2D>;
+    auto pool = glados::pool_allocator<int, glados::memory_layout::pointer_2D, counting_2D>{};
+
+    auto wide = pool.allocate(16, 8);
+    pool.deallocate(wide, 16, 8);
+
+    BOOST_CHECK_EQUAL(pool.allocate(8, 8), wide);
+    auto tall = pool.allocate(8, 16);
+    BOOST_CHECK_NE(tall, wide);
+    BOOST_CHECK_EQUAL(counting_2D::allocated.load(), 2);
+
+    pool.deallocate(wide, 8, 8);
+    pool.deallocate(tall, 8, 16);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_2D::deallocated.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(pool_limit_blocks_until_a_block_returns)
+{
+    auto pool = pool_1D{2};
+    auto a = pool.allocate(16);
+    auto b = pool.allocate(16);
+
+    BOOST_CHECK(pool.try_allocate(16) == nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    BOOST_CHECK(pool.allocate_for(16, std::chrono::milliseconds{20}) == nullptr);
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds{20});
+
+    auto waiting = std::async(std::launch::async, [&]() { return pool.allocate(16); });
+    BOOST_CHECK(waiting.wait_for(std::chrono::milliseconds{20}) == std::future_status::timeout);
+
+    pool.deallocate(a, 16);
+    auto c = waiting.get();
+    BOOST_CHECK(c != nullptr);
+
+    pool.deallocate(b, 16);
+    auto d = pool.allocate_for(16, std::chrono::seconds{1});
+    BOOST_CHECK_EQUAL(d, b);
+
+    pool.deallocate(c, 16);
+    pool.deallocate(d, 16);
+    pool.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_limit_counts_blocks_in_use_across_release)
+{
+    auto pool = pool_1D{2};
+    auto a = pool.allocate(16);
+    auto b = pool.allocate(16);
+    pool.deallocate(b, 16);
+
+    // only the idle block is freed, a still counts against the limit
+    pool.release();
+    auto c = pool.try_allocate(16);
+    BOOST_CHECK(c != nullptr);
+    BOOST_CHECK(pool.try_allocate(16) == nullptr);
+
+    pool.deallocate(a, 16);
+    auto d = pool.try_allocate(16);
+    BOOST_CHECK(d != nullptr);
+    BOOST_CHECK(pool.try_allocate(16) == nullptr);
+
+    pool.deallocate(c, 16);
+    auto e = pool.allocate_for(16, std::chrono::seconds{1});
+    BOOST_CHECK(e != nullptr);
+
+    pool.deallocate(d, 16);
+    pool.deallocate(e, 16);
+    pool.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_reserve_prewarms_every_thread)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+    pool.reserve(8, 32);
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 8);
+
+    auto worker = std::thread{[&]() {
+        auto blocks = std::vector<int*>{};
+        for(auto i = 0; i < 8; ++i)
+            blocks.push_back(pool.allocate(32));
+        for(auto p : blocks)
+            pool.deallocate(p, 32);
+    }};
+    worker.join();
+
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 8);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(owning_pool_frees_blocks_returned_after_it)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+
+    auto survivor = pool_1D::smart_pointer{};
+    {
+        auto pool = pool_1D{0, glados::pool_ownership::owning};
+        pool.reserve(2, 16);
+        auto a = pool.allocate_smart(16);
+        survivor = pool.allocate_smart(16);
+        auto moved = std::move(pool);
+        auto b = moved.allocate_smart(16);
+    }
+
+    // the free blocks were released with the pool, the last one follows
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 3);
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 2);
+    survivor.reset();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(owning_pool_releases_its_blocks_on_move_assignment)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    {
+        auto pool = pool_1D{0, glados::pool_ownership::owning};
+        pool.reserve(3, 16);
+        auto held = pool.allocate_smart(16);
+
+        auto other = pool_1D{0, glados::pool_ownership::owning};
+        other.reserve(1, 8);
+        pool = std::move(other);
+
+        // the old pool's free blocks are gone, its last block follows its smart pointer
+        BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 2);
+        held.reset();
+        BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 3);
+
+        // the reserved block of other is served now
+        auto p = pool.allocate(8);
+        BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 4);
+        pool.deallocate(p, 8);
+    }
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), counting_1D::deallocated.load());
+}
+
+BOOST_AUTO_TEST_CASE(pool_stats_high_water_counts_blocks_in_use)
+{
+    auto pool = pool_1D{};
+    pool.track_in_use();
+    pool.reserve(100, 16);
+
+    for(auto round = 0; round < 4; ++round)
+    {
+        auto blocks = std::vector<int*>{};
+        for(auto i = 0; i < 3; ++i)
+            blocks.push_back(pool.allocate(16));
+        for(auto&& b : blocks)
+            pool.deallocate(b, 16);
+    }
+
+    auto s = pool.stats();
+    BOOST_CHECK_EQUAL(s.high_water, 3u);
+    BOOST_CHECK_EQUAL(s.held_high_water, 100u);
+    BOOST_CHECK_EQUAL(s.in_use, 0u);
+    pool.release();
+
+    // a limit counts the blocks in use anyway
+    auto limited = pool_1D{8};
+    auto a = limited.allocate(16);
+    auto b = limited.allocate(16);
+    BOOST_CHECK_EQUAL(limited.stats().in_use, 2u);
+    limited.deallocate(a, 16);
+    limited.deallocate(b, 16);
+    BOOST_CHECK_EQUAL(limited.stats().high_water, 2u);
+    BOOST_CHECK_EQUAL(limited.stats().in_use, 0u);
+    limited.release();
+
+    // without either the fast paths stay off the shared counter
+    auto untracked = pool_1D{};
+    untracked.deallocate(untracked.allocate(16), 16);
+    BOOST_CHECK_EQUAL(untracked.stats().high_water, 0u);
+    untracked.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_stats_track_blocks_and_leaks)
+{
+    auto leaked = glados::pool_stats{};
+    {
+        auto pool = pool_1D{};
+        pool.track_in_use();
+        pool.set_shutdown_report([&](const glados::pool_stats& s) { leaked = s; });
+        pool.reserve(2, 16);
+
+        auto blocks = std::vector<int*>{};
+        for(auto i = 0; i < 4; ++i)
+            blocks.push_back(pool.allocate(16));
+        pool.deallocate(blocks[3], 16);
+        pool.deallocate(blocks[2], 16);
+        blocks.push_back(pool.allocate(16));
+
+        auto s = pool.stats();
+        BOOST_CHECK_EQUAL(s.created, 4u);
+        BOOST_CHECK_EQUAL(s.hits, 3u);
+        BOOST_CHECK_EQUAL(s.misses, 2u);
+        BOOST_CHECK_EQUAL(s.in_use, 3u);
+        BOOST_CHECK_EQUAL(s.free, 1u);
+        BOOST_CHECK_EQUAL(s.high_water, 4u);
+        BOOST_CHECK_EQUAL(s.held_high_water, 4u);
+        BOOST_CHECK_EQUAL(s.bytes_held, 4 * 16 * sizeof(int));
+        BOOST_CHECK_CLOSE(s.hit_rate(), 0.6, 1e-4);
+
+        pool.deallocate(blocks[0], 16);
+        pool.deallocate(blocks[1], 16);
+        pool.release();
+        s = pool.stats();
+        BOOST_CHECK_EQUAL(s.released, 3u);
+        BOOST_CHECK_EQUAL(s.in_use, 1u);
+        BOOST_CHECK_EQUAL(s.bytes_held, 16 * sizeof(int));
+        BOOST_CHECK_EQUAL(s.high_water, 4u);
+        BOOST_CHECK_EQUAL(s.held_high_water, 4u);
+
+        // a manual pool would leak this block
+        pool.deallocate(blocks[4], 16);
+        pool.release();
+    }
+    BOOST_CHECK_EQUAL(leaked.in_use, 0u);
+    BOOST_CHECK_EQUAL(leaked.bytes_held, 0u);
+    BOOST_CHECK_EQUAL(leaked.released, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(pool_stats_count_time_waiting_for_the_limit)
+{
+    auto pool = pool_1D{1};
+    auto p = pool.allocate(8);
+    BOOST_CHECK(pool.stats().wait_time == std::chrono::nanoseconds{0});
+
+    auto waiter = std::async(std::launch::async, [&]() { return pool.allocate(8); });
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    pool.deallocate(p, 8);
+    auto q = waiter.get();
+
+    BOOST_CHECK(pool.stats().wait_time >= std::chrono::milliseconds{10});
+    BOOST_CHECK_EQUAL(pool.stats().in_use, 1u);
+    pool.deallocate(q, 8);
+    pool.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_smart_pointers_carry_only_home_and_shape)
+{
+    BOOST_CHECK_EQUAL(sizeof(pool_1D::smart_pointer), sizeof(int*) + sizeof(void*) + sizeof(std::size_t));
+
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+    {
+        auto a = pool.allocate_smart(16);
+        auto b = std::move(a);
+        BOOST_CHECK(a == nullptr);
+        b.reset();
+        auto c = pool.allocate_smart(16);
+    }
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 1);
+    BOOST_CHECK_EQUAL(pool.stats().in_use, 0u);
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(pool_smart_pointers_may_copy_their_deleter)
+{
+    using pool_type = glados::pool_allocator<int, glados::memory_layout::pointer_1D, copying_1D>;
+    using pool_2D = glados::pool_allocator<float, glados::memory_layout::pointer_2D, glados::generic::allocator<float, glados::memory_layout::pointer_2D>>;
+    using pool_3D = glados::pool_allocator<float, glados::memory_layout::pointer_3D, glados::generic::allocator<float, glados::memory_layout::pointer_3D>>;
+    static_assert(std::is_copy_assignable<pool_type::deleter_type>::value, "");
+    static_assert(std::is_copy_assignable<pool_2D::deleter_type>::value, "");
+    static_assert(std::is_copy_assignable<pool_3D::deleter_type>::value, "");
+
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto survivor = pool_type::smart_pointer{};
+    {
+        auto pool = pool_type{0, glados::pool_ownership::owning};
+        auto a = pool.allocate_smart(16);
+        survivor = pool.allocate_smart(16);
+        a.reset();
+    }
+
+    // every copy of the deleter held the home, so the last block still finds its way back
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), 2);
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 1);
+    survivor.reset();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(pool_smart_pointers_of_several_shapes_allocate_nothing)
+{
+    auto pool = pool_1D{};
+
+    // a block of 64 elements is lent to the shape of 32 elements below
+    pool.reserve(1, 16);
+    pool.reserve(1, 64);
+    pool.allocate_smart(32).reset();
+    pool.allocate_smart(16).reset();
+
+    heap_allocations = 0;
+    mutex_locks = 0;
+    for(auto i = 0; i < 100; ++i)
+    {
+        auto a = pool.allocate_smart(16);
+        auto b = pool.allocate_smart(32);
+        BOOST_REQUIRE(a != nullptr);
+        BOOST_REQUIRE(b != nullptr);
+    }
+    BOOST_CHECK_EQUAL(heap_allocations, 0);
+    BOOST_CHECK_EQUAL(mutex_locks, 0);
+
+    // the lent block went back to its own bucket every time
+    auto s = pool.stats();
+    BOOST_CHECK_EQUAL(s.created, 2u);
+    BOOST_CHECK_EQUAL(s.misses, 0u);
+    BOOST_CHECK(pool.allocate_smart(64) != nullptr);
+    BOOST_CHECK_EQUAL(pool.stats().misses, 0u);
+
+    pool.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_reuses_blocks_of_exited_threads)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    // one short-lived thread per task, like task_pipeline's stages
+    for(auto i = 0; i < 100; ++i)
+    {
+        auto t = std::thread{[&pool]() { pool.deallocate(pool.allocate(32), 32); }};
+        t.join();
+    }
+
+    auto s = pool.stats();
+    BOOST_CHECK_EQUAL(s.created, 1u);
+    BOOST_CHECK_EQUAL(s.hits, 99u);
+    BOOST_CHECK_EQUAL(s.misses, 1u);
+
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(pool_hands_out_blocks_once_across_threads)
+{
+    constexpr auto threads = 4;
+    constexpr auto rounds = 20000;
+
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{};
+
+    // every block is owned by one thread at a time, the other half is freed by a different thread
+    auto handoff = glados::pipeline::blocking_queue<int*>{};
+    std::atomic<bool> corrupted{false};
+    auto workers = std::vector<std::thread>{};
+    for(auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            for(auto i = 0; i < rounds; ++i)
+            {
+                auto p = pool.allocate(4);
+                p[0] = t;
+                p[1] = i;
+                std::this_thread::yield();
+                if((p[0] != t) || (p[1] != i))
+                    corrupted = true;
+
+                if((t % 2 == 0) && (i % 2 == 0))
+                    handoff.push(std::move(p));
+                else
+                    pool.deallocate(p, 4);
+
+                if((t % 2 == 1) && (handoff.size() > 0))
+                    pool.deallocate(handoff.pop(), 4);
+            }
+        });
+    }
+
+    for(auto&& w : workers)
+        w.join();
+
+    while(handoff.size() > 0)
+        pool.deallocate(handoff.pop(), 4);
+
+    BOOST_CHECK(!corrupted.load());
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::allocated.load(), counting_1D::deallocated.load());
+}
+
+BOOST_AUTO_TEST_CASE(pool_limit_caps_blocks_freed_on_another_thread)
+{
+    counting_1D::allocated = 0;
+    counting_1D::deallocated = 0;
+    auto pool = pool_1D{2};
+
+    // two stages: the producer allocates, the consumer frees
+    auto queue = glados::pipeline::blocking_queue<int*>{};
+    auto consumer = std::thread{[&]() {
+        for(auto i = 0; i < 1000; ++i)
+            pool.deallocate(queue.pop(), 64);
+    }};
+
+    for(auto i = 0; i < 1000; ++i)
+        queue.push(pool.allocate(64));
+    consumer.join();
+
+    auto s = pool.stats();
+    BOOST_CHECK_LE(s.created, 2u);
+    BOOST_CHECK_EQUAL(s.free, s.created);
+    BOOST_CHECK_LE(counting_1D::allocated.load(), 2);
+
+    pool.release();
+    BOOST_CHECK_EQUAL(counting_1D::deallocated.load(), counting_1D::allocated.load());
+}
+
+BOOST_AUTO_TEST_CASE(pool_2d_and_3d)
+{
+    using counting_2D = counting_allocator<float, glados::memory_layout::pointer_2D>;
+    using counting_3D = counting_allocator<float, glados::memory_layout::pointer_3D>;
+
+    auto pool2 = glados::pool_allocator<float, glados::memory_layout::pointer_2D, counting_2D>{2};
+    auto pool3 = glados::pool_allocator<float, glados::memory_layout::pointer_3D, counting_3D>{2};
+    for(auto i = 0; i < 10; ++i)
+    {
+        auto a = pool2.allocate_smart(16, 16);
+        auto b = pool3.allocate_smart(4, 4, 4);
+        a[255] = 1.f;
+        b[63] = 1.f;
+    }
+
+    BOOST_CHECK_EQUAL(counting_2D::allocated.load(), 1);
+    BOOST_CHECK_EQUAL(counting_3D::allocated.load(), 1);
+    pool2.release();
+    pool3.release();
+    BOOST_CHECK_EQUAL(counting_2D::deallocated.load(), 1);
+    BOOST_CHECK_EQUAL(counting_3D::deallocated.load(), 1);
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Date: 16 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE ThreadPool
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/thread_pool.h>
+
+BOOST_AUTO_TEST_CASE(thread_pool_returns_results)
+{
+    glados::generic::thread_pool pool{4};
+    BOOST_CHECK_EQUAL(pool.size(), 4u);
+
+    auto futures = std::vector<std::future<int>>{};
+    for(auto i = 0; i < 100; ++i)
+        futures.emplace_back(pool.submit([i]() { return i * i; }));
+
+    for(auto i = 0; i < 100; ++i)
+        BOOST_CHECK_EQUAL(futures[static_cast<std::size_t>(i)].get(), i * i);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_forwards_exceptions)
+{
+    glados::generic::thread_pool pool{1};
+    auto f = pool.submit([]() { throw std::runtime_error{"failed"}; });
+    BOOST_CHECK_THROW(f.get(), std::runtime_error);
+
+    // the worker survives the exception
+    BOOST_CHECK_EQUAL(pool.submit([]() { return 42; }).get(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_reuses_threads)
+{
+    glados::generic::thread_pool pool{2};
+    auto ids = std::vector<std::thread::id>(50);
+    for(auto&& id : ids)
+        pool.submit([&id]() { id = std::this_thread::get_id(); }).get();
+
+    std::sort(std::begin(ids), std::end(ids));
+    auto distinct = std::unique(std::begin(ids), std::end(ids)) - std::begin(ids);
+    BOOST_CHECK_LE(distinct, 2);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_drains_on_destruction)
+{
+    std::atomic<int> counter{0};
+    {
+        glados::generic::thread_pool pool{3};
+        for(auto i = 0; i < 1000; ++i)
+            pool.submit([&counter]() { ++counter; });
+    }
+    BOOST_CHECK_EQUAL(counter.load(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_pins_workers)
+{
+    glados::generic::thread_pool pool{std::vector<int>{0, 0}};
+    BOOST_CHECK_EQUAL(pool.size(), 2u);
+    BOOST_CHECK_EQUAL(pool.submit([]() { return 1; }).get(), 1);
+
+    BOOST_CHECK_THROW(glados::generic::thread_pool{std::vector<int>{}}, std::invalid_argument);
+}